@@ -0,0 +1,215 @@
+#include "BenchmarkInputs.h"
+#include "InputGenerators.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <stdexcept>
+#include <vector>
+
+#include <unistd.h>
+
+#ifdef AOC_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifndef AOC_SOURCE_DIR
+#define AOC_SOURCE_DIR "."
+#endif
+
+static std::string readWholeFile(const std::string& path) {
+
+    std::ifstream f(path, std::ios::binary);
+    std::stringstream ss;
+    ss << f.rdbuf();
+    return ss.str();
+}
+
+// 64-bit FNV-1a of everything a cached file depends on
+static std::string cacheKey(const std::string& description) {
+
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : description) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+
+    std::ostringstream hex;
+    hex << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return hex.str();
+}
+
+// writes a cached file under a temporary name, then renames it into place
+template <typename Write>
+static void writeCached(const std::string& path, Write write) {
+
+    namespace fs = std::filesystem;
+
+    if (fs::exists(path)) return;
+
+    std::string temporary = path + ".tmp" + std::to_string(getpid());
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        write(out);
+        out.close();
+        if (!out) {
+            fs::remove(temporary);
+            throw std::runtime_error("cannot write benchmark input " + path);
+        }
+    }
+    fs::rename(temporary, path);
+}
+
+// fills in the byte and line counts of an input file
+static void measureInput(ScaledInput& input) {
+
+    std::string contents = readWholeFile(input.path);
+    input.bytes = (int64_t)contents.size();
+    for (char c : contents)
+        if (c == '\n') input.lines++;
+}
+
+void setCounters(benchmark::State& state, const ScaledInput& input, int64_t items) {
+
+    state.SetBytesProcessed(state.iterations() * input.bytes);
+    state.SetItemsProcessed(state.iterations() * (items < 0 ? input.lines : items));
+}
+
+ScaledInput scaledInput(int day, int copies) {
+
+    namespace fs = std::filesystem;
+
+    std::string original = readWholeFile(std::string(AOC_SOURCE_DIR) + "/Day_" + std::to_string(day) + "/input.txt");
+    if (!original.empty() && original.back() != '\n')
+        original += '\n';
+
+    ScaledInput input;
+    input.path = (fs::temp_directory_path()
+                  / ("aoc2023-day" + std::to_string(day) + "-x" + std::to_string(copies)
+                     + "-" + cacheKey(original) + ".txt")).string();
+
+    writeCached(input.path, [&](std::ofstream& out) {
+
+        if (day == 5) {
+            // one almanac: repeat the seed pairs, keep the maps
+            size_t lineEnd = original.find('\n');
+            std::string seedPairs = original.substr(6, lineEnd - 6);
+
+            out << "seeds:";
+            for (int i = 0; i < copies; ++i)
+                out << seedPairs;
+            out << original.substr(lineEnd);
+        }
+        else {
+            for (int i = 0; i < copies; ++i)
+                out << original;
+        }
+    });
+
+    measureInput(input);
+    return input;
+}
+
+ScaledInput generatedInput(int day, int64_t size) {
+
+    namespace fs = std::filesystem;
+
+    CalibrationParams calibration;
+    GameParams games;
+    SchematicParams schematic;
+    CardParams cards;
+    AlmanacParams almanac;
+
+    calibration.lines = size;
+    games.games = size;
+    schematic.rows = schematic.cols = (int)size;
+    cards.cards = size;
+    almanac.seedRanges = (int)size;
+    almanac.rulesPerMap = 100;
+
+    if (day == 3) return generatedSchematic(schematic);
+
+    // every parameter of the generator used, seed included
+    std::ostringstream params;
+    params << std::setprecision(17) << "day" << day;
+    switch (day) {
+        case 1: params << " lines=" << calibration.lines << " lineLength=" << calibration.lineLength
+                       << " spelled=" << calibration.spelledDensity << " digits=" << calibration.digitDensity
+                       << " seed=" << calibration.seed; break;
+        case 2: params << " games=" << games.games << " draws=" << games.draws << " max=" << games.maxCount
+                       << " colors=" << games.colors << " seed=" << games.seed; break;
+        case 4: params << " cards=" << cards.cards << " winning=" << cards.winning << " numbers=" << cards.numbers
+                       << " maxValue=" << cards.maxValue << " maxMatches=" << cards.maxMatches
+                       << " matchChance=" << cards.matchChance << " blockSize=" << cards.blockSize
+                       << " seed=" << cards.seed; break;
+        case 5: params << " ranges=" << almanac.seedRanges << " rules=" << almanac.rulesPerMap
+                       << " length=" << almanac.maxRangeLength << " seed=" << almanac.seed; break;
+    }
+
+    ScaledInput input;
+    input.path = (fs::temp_directory_path()
+                  / ("aoc2023-day" + std::to_string(day) + "-gen" + std::to_string(size)
+                     + "-" + cacheKey(params.str()) + ".txt")).string();
+
+    writeCached(input.path, [&](std::ofstream& out) {
+
+        switch (day) {
+            case 1: generateCalibration(out, calibration); break;
+            case 2: generateGames(out, games); break;
+            case 4: generateCards(out, cards); break;
+            case 5: generateAlmanac(out, almanac); break;
+        }
+    });
+
+    measureInput(input);
+    return input;
+}
+
+ScaledInput generatedSchematic(const SchematicParams& schematic) {
+
+    namespace fs = std::filesystem;
+
+    std::ostringstream params;
+    params << std::setprecision(17) << "day3"
+           << " rows=" << schematic.rows << " cols=" << schematic.cols
+           << " numbers=" << schematic.numberDensity << " symbols=" << schematic.symbolDensity
+           << " seed=" << schematic.seed;
+
+    ScaledInput input;
+    input.path = (fs::temp_directory_path()
+                  / ("aoc2023-day3-gen" + std::to_string(schematic.rows) + "x" + std::to_string(schematic.cols)
+                     + "-" + cacheKey(params.str()) + ".txt")).string();
+
+    writeCached(input.path, [&](std::ofstream& out) { generateSchematic(out, schematic); });
+
+    measureInput(input);
+    return input;
+}
+
+#ifdef AOC_HAVE_ZLIB
+ScaledInput gzipInput(const ScaledInput& input) {
+
+    ScaledInput compressed = input;
+    compressed.path = input.path + ".gz";
+
+    if (!std::filesystem::exists(compressed.path)) {
+
+        std::string contents = readWholeFile(input.path);
+        std::string temporary = compressed.path + ".tmp" + std::to_string(getpid());
+
+        gzFile out = gzopen(temporary.c_str(), "wb6");
+        bool written = out != nullptr
+            && gzwrite(out, contents.data(), (unsigned)contents.size()) == (int)contents.size();
+        if (out != nullptr && gzclose(out) != Z_OK) written = false;
+
+        if (!written) {
+            std::filesystem::remove(temporary);
+            throw std::runtime_error("cannot write benchmark input " + compressed.path);
+        }
+        std::filesystem::rename(temporary, compressed.path);
+    }
+
+    return compressed;
+}
+#endif
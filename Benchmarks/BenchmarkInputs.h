@@ -0,0 +1,122 @@
+#ifndef BENCHMARK_INPUTS_H
+#define BENCHMARK_INPUTS_H
+
+#include "InputGenerators.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <streambuf>
+#include <iostream>
+#include <cstdint>
+
+// Shared helpers for the solver benchmarks.
+
+
+/**
+ * @struct ScaledInput
+ * @brief A benchmark input file together with its size.
+ */
+
+struct ScaledInput {
+    std::string path;
+    int64_t bytes = 0;
+    int64_t lines = 0;
+};
+
+
+/**
+ * @brief Returns an input file made of 'copies' copies of a bundled input.
+ *
+ * The file is cached in the temporary directory. Its name includes a
+ * hash of the bundled input, so editing the input writes a new file.
+ * Day 5 repeats only the seed pairs of the "seeds:" line, so the result
+ * is still a single valid almanac with 'copies' times as many seeds.
+ *
+ * @param day Day number (1-5), selects Day_<day>/input.txt.
+ * @param copies Scale factor.
+ * @return Path and size of the scaled input.
+ */
+ScaledInput scaledInput(int day, int copies);
+
+/**
+ * @brief Returns a synthetic input from Generators/ with a fixed seed.
+ *
+ * 'size' is the number of lines (Day 1), games (Day 2), rows and
+ * columns (Day 3), cards (Day 4) or seed ranges (Day 5, with 100 rules
+ * per map). Other parameters keep their defaults, so the files are
+ * identical from run to run.
+ *
+ * The cached file's name includes a hash of every generator parameter
+ * and the seed, so changing a default writes a new file.
+ *
+ * @param day Day number (1-5).
+ * @param size Scale of the generated input.
+ * @return Path and size of the generated input.
+ */
+ScaledInput generatedInput(int day, int64_t size);
+
+/**
+ * @brief Returns a synthetic Day 3 schematic of any shape and density.
+ *
+ * generatedInput(3, size) is this with rows = cols = size and the
+ * default densities. Cached the same way.
+ */
+ScaledInput generatedSchematic(const SchematicParams& params);
+
+#ifdef AOC_HAVE_ZLIB
+/**
+ * @brief Returns a gzip-compressed copy of an input ("<path>.gz").
+ *
+ * bytes and lines still describe the uncompressed contents, so the
+ * throughput of compressed and plain benchmarks compares directly.
+ *
+ * Like every cached input, it is written under a temporary name and
+ * renamed into place, so an interrupted run never leaves a truncated
+ * file behind.
+ */
+ScaledInput gzipInput(const ScaledInput& input);
+#endif
+
+
+/**
+ * @brief Reports the throughput of a benchmark over an input.
+ *
+ * Bytes are the input's size; items are its lines unless the
+ * benchmark counts something else (seeds, seed ranges, ...).
+ *
+ * @param state The running benchmark.
+ * @param input Input processed once per iteration.
+ * @param items Items processed per iteration; -1 = input.lines.
+ */
+void setCounters(benchmark::State& state, const ScaledInput& input, int64_t items = -1);
+
+
+/**
+ * @class QuietStdout
+ * @brief Discards everything written to std::cout while in scope.
+ *
+ * The solvers print progress messages while parsing; those must not
+ * be part of the measurement (or mix with the benchmark report).
+ */
+
+class QuietStdout {
+
+public:
+
+    QuietStdout() : previous(std::cout.rdbuf(&sink)) {}
+    ~QuietStdout() { std::cout.rdbuf(previous); }
+
+private:
+
+    struct NullBuffer : std::streambuf {
+        int overflow(int c) override { return c; }
+        std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+    };
+
+    NullBuffer sink;
+    std::streambuf* previous;
+};
+
+
+#endif // BENCHMARK_INPUTS_H
@@ -0,0 +1,88 @@
+#include "BenchmarkInputs.h"
+#include "WeatherCalibration.h"
+
+#include <benchmark/benchmark.h>
+
+// Day 1 - Trebuchet?!  (size = copies of the bundled input)
+
+static void BM_Day1_Parse(benchmark::State& state) {
+
+    ScaledInput input = scaledInput(1, (int)state.range(0));
+    QuietStdout quiet;
+
+    for (auto _ : state) {
+        WeatherCalibration1 w(input.path);
+        w.readPuzzleInput1();
+        benchmark::DoNotOptimize(w.digitValues.data());
+    }
+
+    setCounters(state, input);
+}
+
+static void BM_Day1_Part1(benchmark::State& state) {
+
+    ScaledInput input = scaledInput(1, (int)state.range(0));
+    QuietStdout quiet;
+
+    WeatherCalibration1 w(input.path);
+    w.readPuzzleInput1();
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(w.getSolutionPart1());
+
+    setCounters(state, input);
+}
+
+static void BM_Day1_Part2(benchmark::State& state) {
+
+    ScaledInput input = scaledInput(1, (int)state.range(0));
+    QuietStdout quiet;
+
+    WeatherCalibration1 w(input.path);
+    w.readPuzzleInput1();
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(w.getSolutionPart2());
+
+    setCounters(state, input);
+}
+
+// the find()-based reference, computeCalibrationValue2 per line
+static void BM_Day1_Part2Find(benchmark::State& state) {
+
+    ScaledInput input = scaledInput(1, (int)state.range(0));
+    QuietStdout quiet;
+
+    WeatherCalibration1 w(input.path);
+    w.readPuzzleInput1();
+
+    for (auto _ : state) {
+        int solution = 0;
+        for (int i = 0; i < (int)w.calibrationLines.size(); ++i)
+            solution += w.computeCalibrationValue2(i);
+        benchmark::DoNotOptimize(solution);
+    }
+
+    setCounters(state, input);
+}
+
+// synthetic documents: size = number of lines
+static void BM_Day1_Part2Generated(benchmark::State& state) {
+
+    ScaledInput input = generatedInput(1, state.range(0));
+    QuietStdout quiet;
+
+    WeatherCalibration1 w(input.path);
+    w.readPuzzleInput1();
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(w.getSolutionPart2());
+
+    setCounters(state, input);
+}
+
+BENCHMARK(BM_Day1_Parse)->RangeMultiplier(4)->Range(1, 64)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Day1_Part1)->RangeMultiplier(4)->Range(1, 64)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Day1_Part2)->RangeMultiplier(4)->Range(1, 64)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Day1_Part2Find)->RangeMultiplier(4)->Range(1, 64)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Day1_Part2Generated)->RangeMultiplier(8)->Range(1 << 10, 1 << 19)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,50 @@
+#include "BenchmarkInputs.h"
+#include "CubeConundrum.h"
+
+#include <benchmark/benchmark.h>
+
+// Day 2 - Cube Conundrum  (size = copies of the bundled input)
+
+static void BM_Day2_Parse(benchmark::State& state) {
+
+    ScaledInput input = scaledInput(2, (int)state.range(0));
+    QuietStdout quiet;
+
+    // the constructor reads the input
+    for (auto _ : state) {
+        CubeConundrum c(input.path);
+        benchmark::DoNotOptimize(c.games.data());
+    }
+
+    setCounters(state, input);
+}
+
+static void BM_Day2_Part1(benchmark::State& state) {
+
+    ScaledInput input = scaledInput(2, (int)state.range(0));
+    QuietStdout quiet;
+
+    CubeConundrum c(input.path);
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(c.getSolutionPart1());
+
+    setCounters(state, input);
+}
+
+static void BM_Day2_Part2(benchmark::State& state) {
+
+    ScaledInput input = scaledInput(2, (int)state.range(0));
+    QuietStdout quiet;
+
+    CubeConundrum c(input.path);
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(c.getSolutionPart2());
+
+    setCounters(state, input);
+}
+
+BENCHMARK(BM_Day2_Parse)->RangeMultiplier(4)->Range(1, 256)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Day2_Part1)->RangeMultiplier(4)->Range(1, 256)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Day2_Part2)->RangeMultiplier(4)->Range(1, 256)->Unit(benchmark::kMicrosecond);
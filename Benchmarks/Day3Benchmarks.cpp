@@ -0,0 +1,150 @@
+#include "BenchmarkInputs.h"
+#include "GearRatios.h"
+
+#include <benchmark/benchmark.h>
+
+// Day 3 - Gear Ratios  (size = copies of the bundled schematic, stacked)
+//
+// isPartNumber compares a number with every symbol, so it runs on
+// smaller sizes; Part 1 and Part 2 are queries on the prebuilt graph.
+
+static void BM_Day3_Parse(benchmark::State& state) {
+
+    ScaledInput input = scaledInput(3, (int)state.range(0));
+    QuietStdout quiet;
+
+    for (auto _ : state) {
+        GearRatios g(input.path);
+        g.readPuzzleInput();
+        g.parseFullSchematic(false);
+        benchmark::DoNotOptimize(g.numbers.data());
+    }
+
+    setCounters(state, input);
+}
+
+static void BM_Day3_IsPartNumber(benchmark::State& state) {
+
+    ScaledInput input = scaledInput(3, (int)state.range(0));
+    QuietStdout quiet;
+
+    GearRatios g(input.path);
+    g.readPuzzleInput();
+    g.parseFullSchematic(false);
+
+    for (auto _ : state) {
+        for (int i = 0; i < (int)g.numbers.size(); ++i)
+            benchmark::DoNotOptimize(g.isPartNumber(i, false));
+    }
+
+    state.SetItemsProcessed(state.iterations() * (int64_t)g.numbers.size());
+}
+
+static void BM_Day3_Part1(benchmark::State& state) {
+
+    ScaledInput input = scaledInput(3, (int)state.range(0));
+    QuietStdout quiet;
+
+    GearRatios g(input.path);
+    g.readPuzzleInput();
+    g.parseFullSchematic(false);
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(g.getSolutionPart1());
+
+    setCounters(state, input);
+}
+
+static void BM_Day3_Part2(benchmark::State& state) {
+
+    ScaledInput input = scaledInput(3, (int)state.range(0));
+    QuietStdout quiet;
+
+    GearRatios g(input.path);
+    g.readPuzzleInput();
+    g.parseFullSchematic(false);
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(g.getSolutionPart2());
+
+    setCounters(state, input);
+}
+
+static void BM_Day3_BuildGraph(benchmark::State& state) {
+
+    ScaledInput input = scaledInput(3, (int)state.range(0));
+    QuietStdout quiet;
+
+    GearRatios g(input.path);
+    g.readPuzzleInput();
+    g.parseFullSchematic(false);
+
+    for (auto _ : state) {
+        SchematicGraph graph;
+        graph.build(g.numbers, g.symbols);
+        benchmark::DoNotOptimize(graph.symbolNumbers.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * (int64_t)(g.numbers.size() + g.symbols.size()));
+}
+
+// synthetic schematics: size = rows = columns
+static void BM_Day3_ParseGenerated(benchmark::State& state) {
+
+    ScaledInput input = generatedInput(3, state.range(0));
+    QuietStdout quiet;
+
+    for (auto _ : state) {
+        GearRatios g(input.path);
+        g.readPuzzleInput();
+        g.parseFullSchematic(false);
+        benchmark::DoNotOptimize(g.numbers.data());
+    }
+
+    setCounters(state, input);
+}
+
+// only the row tokenizer, on a loaded grid
+static void tokenizeRows(benchmark::State& state, const ScaledInput& input) {
+
+    QuietStdout quiet;
+
+    GearRatios g(input.path);
+    g.readPuzzleInput();
+
+    for (auto _ : state) {
+        g.numbers.clear();
+        g.symbols.clear();
+        for (int r = 0; r < g.schematic.rows; ++r)
+            g.parseSchematicLine(r, false);
+        benchmark::DoNotOptimize(g.numbers.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * (int64_t)g.schematic.rows * g.schematic.cols);
+}
+
+static void BM_Day3_TokenizeGenerated(benchmark::State& state) {
+    tokenizeRows(state, generatedInput(3, state.range(0)));
+}
+
+// wide, sparse rows: mostly '.' blocks, where the 64-cell masks skip ahead
+static void BM_Day3_TokenizeSparse(benchmark::State& state) {
+
+    SchematicParams params;
+    params.rows = (int)state.range(0);
+    params.cols = (int)state.range(1);
+    params.numberDensity = 0.002;
+    params.symbolDensity = 0.001;
+
+    tokenizeRows(state, generatedSchematic(params));
+}
+
+
+BENCHMARK(BM_Day3_Parse)->RangeMultiplier(4)->Range(1, 64)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Day3_IsPartNumber)->RangeMultiplier(2)->Range(1, 8)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Day3_Part1)->RangeMultiplier(4)->Range(1, 64)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Day3_Part2)->RangeMultiplier(4)->Range(1, 64)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Day3_BuildGraph)->RangeMultiplier(4)->Range(1, 64)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Day3_ParseGenerated)->RangeMultiplier(4)->Range(256, 4096)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Day3_TokenizeGenerated)->RangeMultiplier(4)->Range(256, 4096)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Day3_TokenizeSparse)->Args({100, 100000})->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,197 @@
+#include "BenchmarkInputs.h"
+#include "CardMatcher.h"
+#include "Scratchcard.h"
+#include "ScratchcardStream.h"
+#include "ScratchcardWhatIf.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+
+// Day 4 - Scratchcards  (size = copies of the bundled input)
+
+static void BM_Day4_Parse(benchmark::State& state) {
+
+    ScaledInput input = scaledInput(4, (int)state.range(0));
+    QuietStdout quiet;
+
+    for (auto _ : state) {
+        Scratchcard s(input.path);
+        s.readPuzzleInput();
+        benchmark::DoNotOptimize(s.cards.data());
+    }
+
+    setCounters(state, input);
+}
+
+#ifdef AOC_HAVE_ZLIB
+// same as BM_Day4_Parse on a .gz copy, inflated on the reader thread
+static void BM_Day4_ParseGzip(benchmark::State& state) {
+
+    ScaledInput input = gzipInput(scaledInput(4, (int)state.range(0)));
+    QuietStdout quiet;
+
+    for (auto _ : state) {
+        Scratchcard s(input.path);
+        s.readPuzzleInput();
+        benchmark::DoNotOptimize(s.cards.data());
+    }
+
+    setCounters(state, input);
+}
+#endif
+
+static void BM_Day4_Part1(benchmark::State& state) {
+
+    ScaledInput input = scaledInput(4, (int)state.range(0));
+    QuietStdout quiet;
+
+    Scratchcard s(input.path);
+    s.readPuzzleInput();
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(s.getSolutionPart1());
+
+    setCounters(state, input);
+}
+
+static void BM_Day4_ProcessMatches(benchmark::State& state) {
+
+    ScaledInput input = scaledInput(4, (int)state.range(0));
+    QuietStdout quiet;
+
+    Scratchcard s(input.path);
+    s.readPuzzleInput();
+    s.initializeStructuresForPart2();
+
+    for (auto _ : state) {
+        std::fill(s.copies.begin(), s.copies.end(), 1);
+        s.processMatches();
+        benchmark::DoNotOptimize(s.copies.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * (int64_t)s.cards.size());
+}
+
+static void BM_Day4_Part2(benchmark::State& state) {
+
+    ScaledInput input = scaledInput(4, (int)state.range(0));
+    QuietStdout quiet;
+
+    Scratchcard s(input.path);
+    s.readPuzzleInput();
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(s.getSolutionPart2());
+
+    setCounters(state, input);
+}
+
+// synthetic cards: size = number of cards
+static void BM_Day4_Part2Generated(benchmark::State& state) {
+
+    ScaledInput input = generatedInput(4, state.range(0));
+    QuietStdout quiet;
+
+    Scratchcard s(input.path);
+    s.readPuzzleInput();
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(s.getSolutionPart2());
+
+    setCounters(state, input);
+}
+
+// parse and solve in one pass, without storing the cards
+static void BM_Day4_StreamGenerated(benchmark::State& state) {
+
+    ScaledInput input = generatedInput(4, state.range(0));
+    QuietStdout quiet;
+
+    for (auto _ : state) {
+        ScratchcardStream s(input.path);
+        s.readPuzzleInput();
+        benchmark::DoNotOptimize(s.part2);
+    }
+
+    setCounters(state, input);
+}
+
+// what-if queries and committed updates of one card's match count
+static void BM_Day4_WhatIf(benchmark::State& state) {
+
+    ScaledInput input = generatedInput(4, state.range(0));
+    QuietStdout quiet;
+
+    Scratchcard s(input.path);
+    s.readPuzzleInput();
+    ScratchcardWhatIf w(s);
+
+    uint64_t x = 1;
+    for (auto _ : state) {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        benchmark::DoNotOptimize(w.whatIf((int)((x >> 33) % w.matches.size()), (int)((x >> 20) % 11)));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_Day4_WhatIfUpdate(benchmark::State& state) {
+
+    ScaledInput input = generatedInput(4, state.range(0));
+    QuietStdout quiet;
+
+    Scratchcard s(input.path);
+    s.readPuzzleInput();
+    ScratchcardWhatIf w(s);
+
+    uint64_t x = 1;
+    for (auto _ : state) {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        w.update((int)((x >> 33) % w.matches.size()), (int)((x >> 20) % 11));
+        benchmark::DoNotOptimize(w.total);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// match counting on synthetic cards with numbers up to 2^31
+// (range(0) = numbers per side, range(1) = CardMatcher)
+static void BM_Day4_MatchWide(benchmark::State& state) {
+
+    size_t width = (size_t)state.range(0);
+    CardMatcher matcher = (CardMatcher)state.range(1);
+
+    std::mt19937 rng(4);
+    std::vector<std::vector<int>> numbers(256), winning(256);
+
+    for (size_t c = 0; c < numbers.size(); ++c) {
+        for (size_t i = 0; i < width; ++i) winning[c].push_back((int)(rng() >> 1));
+        for (size_t i = 0; i < width; ++i)
+            numbers[c].push_back(rng() % 4 == 0 ? winning[c][rng() % width] : (int)(rng() >> 1));
+
+        std::sort(numbers[c].begin(), numbers[c].end());
+        std::sort(winning[c].begin(), winning[c].end());
+        winning[c].erase(std::unique(winning[c].begin(), winning[c].end()), winning[c].end());
+    }
+
+    for (auto _ : state)
+        for (size_t c = 0; c < numbers.size(); ++c)
+            benchmark::DoNotOptimize(countCardMatches(numbers[c], winning[c], matcher));
+
+    state.SetItemsProcessed(state.iterations() * numbers.size() * width);
+}
+
+BENCHMARK(BM_Day4_Parse)->RangeMultiplier(4)->Range(1, 64)->Unit(benchmark::kMicrosecond);
+#ifdef AOC_HAVE_ZLIB
+BENCHMARK(BM_Day4_ParseGzip)->RangeMultiplier(4)->Range(1, 64)->Unit(benchmark::kMicrosecond);
+#endif
+BENCHMARK(BM_Day4_Part1)->RangeMultiplier(4)->Range(1, 64)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Day4_ProcessMatches)->RangeMultiplier(4)->Range(1, 64)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Day4_Part2)->RangeMultiplier(4)->Range(1, 64)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Day4_Part2Generated)->RangeMultiplier(8)->Range(1 << 10, 1 << 19)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Day4_StreamGenerated)->RangeMultiplier(8)->Range(1 << 10, 1 << 19)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Day4_WhatIf)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK(BM_Day4_WhatIfUpdate)->RangeMultiplier(8)->Range(1 << 10, 1 << 19)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Day4_MatchWide)->ArgsProduct({{16, 64, 256}, {(int)CardMatcher::Simd, (int)CardMatcher::Galloping, (int)CardMatcher::Merge}});
@@ -0,0 +1,86 @@
+#include "BenchmarkInputs.h"
+#include "Almanac.h"
+
+#include <benchmark/benchmark.h>
+
+// Day 5 - If You Give A Seed A Fertilizer  (size = copies of the seed list)
+
+static void BM_Day5_Parse(benchmark::State& state) {
+
+    ScaledInput input = scaledInput(5, (int)state.range(0));
+    QuietStdout quiet;
+
+    for (auto _ : state) {
+        Almanac a(input.path);
+        a.readPuzzleInput();
+        benchmark::DoNotOptimize(a.ruleMaps.data());
+    }
+
+    setCounters(state, input);
+}
+
+static void BM_Day5_Part1(benchmark::State& state) {
+
+    ScaledInput input = scaledInput(5, (int)state.range(0));
+    QuietStdout quiet;
+
+    Almanac a(input.path);
+    a.readPuzzleInput();
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(a.getSolutionPart1());
+
+    setCounters(state, input, (int64_t)a.seeds.size());
+}
+
+static void BM_Day5_ApplyMapToIntervals(benchmark::State& state) {
+
+    ScaledInput input = scaledInput(5, (int)state.range(0));
+    QuietStdout quiet;
+
+    Almanac a(input.path);
+    a.readPuzzleInput();
+    a.setSeedIntervals();
+
+    for (auto _ : state) {
+        std::vector<Interval> output = a.applyMapToIntervals(a.ruleMaps[0], a.seedIntervals);
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    setCounters(state, input, (int64_t)a.seedIntervals.size());
+}
+
+static void BM_Day5_Part2(benchmark::State& state) {
+
+    ScaledInput input = scaledInput(5, (int)state.range(0));
+    QuietStdout quiet;
+
+    Almanac a(input.path);
+    a.readPuzzleInput();
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(a.getSolutionPart2());
+
+    setCounters(state, input, (int64_t)a.seeds.size() / 2);
+}
+
+// synthetic almanacs: size = number of seed ranges (100 rules per map)
+static void BM_Day5_Part2Generated(benchmark::State& state) {
+
+    ScaledInput input = generatedInput(5, state.range(0));
+    QuietStdout quiet;
+
+    Almanac a(input.path);
+    a.readPuzzleInput();
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(a.getSolutionPart2());
+
+    setCounters(state, input, (int64_t)a.seeds.size() / 2);
+}
+
+BENCHMARK(BM_Day5_Parse)->RangeMultiplier(8)->Range(1, 512)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Day5_Part1)->RangeMultiplier(8)->Range(1, 512)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Day5_ApplyMapToIntervals)->RangeMultiplier(8)->Range(1, 512)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Day5_Part2)->RangeMultiplier(8)->Range(1, 512)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Day5_Part2Generated)->RangeMultiplier(8)->Range(8, 4096)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,191 @@
+#include "ChunkedReader.h"
+#include "InputSource.h"
+
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// buffers in flight: one parsed, one being read, one ready in between
+static const int RING_SIZE = 3;
+
+void LineConsumer::consumeChunk(const char* data, size_t size) {
+
+    const char* end = data + size;
+
+    while (data < end) {
+
+        const char* newline = static_cast<const char*>(std::memchr(data, '\n', end - data));
+        const char* lineEnd = newline ? newline : end;
+
+        lineBuffer.assign(data, lineEnd);
+        consumeLine(lineBuffer);
+
+        data = newline ? newline + 1 : end;
+    }
+}
+
+namespace {
+
+// one buffer of the ring
+struct Slot {
+    std::vector<char> data;
+    size_t size = 0;
+};
+
+// hands filled slots from the reader thread to the consumer and back
+struct SlotQueue {
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<int> ready;
+    std::deque<int> free;
+    bool done = false;
+    bool failed = false;
+    bool cancelled = false;
+};
+
+// reads until 'slot' holds 'target' bytes or the input ends
+bool fillSlot(InputSource& source, Slot& slot, size_t target, bool& eof) {
+
+    if (slot.data.size() < target)
+        slot.data.resize(target);
+
+    while (slot.size < target) {
+
+        long n = source.read(slot.data.data() + slot.size, target - slot.size);
+
+        if (n < 0) return false;
+        if (n == 0) { eof = true; return true; }
+
+        slot.size += (size_t)n;
+    }
+
+    return true;
+}
+
+// reader stage: reads (and decompresses) into free slots
+void readerLoop(InputSource& source, size_t chunkSize, std::vector<Slot>& slots, SlotQueue& queue) {
+
+    std::vector<char> carry;   // partial last line of the previous chunk
+    bool eof = false;
+
+    while (!eof) {
+
+        int index;
+        {
+            std::unique_lock<std::mutex> lock(queue.mutex);
+            queue.changed.wait(lock, [&] { return !queue.free.empty() || queue.cancelled; });
+            if (queue.cancelled) return;
+            index = queue.free.front();
+            queue.free.pop_front();
+        }
+
+        Slot& slot = slots[index];
+        slot.size = carry.size();
+        if (slot.data.size() < carry.size() + chunkSize)
+            slot.data.resize(carry.size() + chunkSize);
+        if (!carry.empty()) std::memcpy(slot.data.data(), carry.data(), carry.size());
+
+        size_t target = carry.size() + chunkSize;
+        bool ok = fillSlot(source, slot, target, eof);
+
+        // a line longer than the chunk: keep reading until it ends
+        while (ok && !eof && std::memchr(slot.data.data() + carry.size(), '\n', slot.size - carry.size()) == nullptr) {
+            target += chunkSize;
+            ok = fillSlot(source, slot, target, eof);
+        }
+
+        if (!ok) {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.failed = true;
+            queue.done = true;
+            queue.changed.notify_all();
+            return;
+        }
+
+        // cut after the last newline, the rest starts the next chunk
+        carry.clear();
+        if (!eof) {
+            size_t cut = slot.size;
+            while (cut > 0 && slot.data[cut - 1] != '\n') --cut;
+            carry.assign(slot.data.begin() + cut, slot.data.begin() + slot.size);
+            slot.size = cut;
+        }
+
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.ready.push_back(index);
+        if (eof) queue.done = true;
+        queue.changed.notify_all();
+    }
+}
+
+} // namespace
+
+bool readChunked(const std::string& path, ChunkConsumer& consumer, size_t chunkSize) {
+
+    std::string error;
+    std::unique_ptr<InputSource> source = openInputSource(path, error);
+    if (!source) {
+        std::cerr << error << std::endl;
+        return false;
+    }
+
+    if (chunkSize == 0) chunkSize = 1 << 20;
+
+    std::vector<Slot> slots(RING_SIZE);
+    SlotQueue queue;
+    for (int i = 0; i < RING_SIZE; ++i)
+        queue.free.push_back(i);
+
+    std::thread reader(readerLoop, std::ref(*source), chunkSize, std::ref(slots), std::ref(queue));
+
+    // stops the reader before an exception leaves this function
+    auto stopReader = [&] {
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.cancelled = true;
+        }
+        queue.changed.notify_all();
+        reader.join();
+    };
+
+    try {
+
+        while (true) {
+
+            int index;
+            {
+                std::unique_lock<std::mutex> lock(queue.mutex);
+                queue.changed.wait(lock, [&] { return !queue.ready.empty() || queue.done; });
+                if (queue.ready.empty()) break;
+                index = queue.ready.front();
+                queue.ready.pop_front();
+            }
+
+            if (slots[index].size > 0)
+                consumer.consumeChunk(slots[index].data.data(), slots[index].size);
+
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.free.push_back(index);
+            queue.changed.notify_all();
+        }
+    }
+    catch (...) {
+        stopReader();
+        throw;
+    }
+
+    stopReader();
+
+    if (queue.failed) {
+        std::cerr << "Error reading " << path << ": " << source->error << std::endl;
+        return false;
+    }
+
+    consumer.finishInput();
+    return true;
+}
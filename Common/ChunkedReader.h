@@ -0,0 +1,80 @@
+#ifndef CHUNKED_READER_H
+#define CHUNKED_READER_H
+
+#include <cstddef>
+#include <string>
+
+
+/**
+ * @class ChunkConsumer
+ * @brief Receives an input file as a sequence of chunks.
+ *
+ * Every chunk ends right after a '\n' (or at the end of the file), so a
+ * line is never split between two chunks.
+ */
+
+class ChunkConsumer {
+public:
+
+    virtual ~ChunkConsumer() = default;
+
+    /**
+     * @brief Processes the next chunk of the input.
+     *
+     * @param data Start of the chunk; only valid during the call.
+     * @param size Number of bytes.
+     */
+    virtual void consumeChunk(const char* data, size_t size) = 0;
+
+    /** @brief Called once after the last chunk. */
+    virtual void finishInput() {}
+};
+
+
+/**
+ * @class LineConsumer
+ * @brief ChunkConsumer that splits chunks into lines.
+ *
+ * Lines are delivered like std::getline would: without the '\n', and
+ * without an empty line after a final '\n'.
+ */
+
+class LineConsumer : public ChunkConsumer {
+public:
+
+    /** @brief Processes one input line. */
+    virtual void consumeLine(const std::string& line) = 0;
+
+    void consumeChunk(const char* data, size_t size) override;
+
+    /** @brief Reused between lines so short lines do not allocate. */
+    std::string lineBuffer;
+};
+
+
+/**
+ * @brief Reads a file on a background thread while the consumer parses it.
+ *
+ * The file is read in chunks of about 'chunkSize' bytes into a small
+ * ring of buffers: while the calling thread runs consumeChunk() on one
+ * chunk, the reader thread already fills the next one (and hints the
+ * kernel to prefetch the one after), so a cold-cache read of a large
+ * file overlaps with parsing instead of preceding it. Chunks are cut
+ * after the last '\n'; a line longer than a chunk grows the buffer.
+ *
+ * gzip and zstd files are recognized by their magic bytes and
+ * decompressed on the reader thread (see openInputSource), so
+ * decompression and parsing run concurrently.
+ *
+ * consumeChunk() and finishInput() run on the calling thread, in order.
+ * An exception thrown by the consumer stops the reader and is rethrown.
+ *
+ * @param path File to read.
+ * @param consumer Receives the chunks.
+ * @param chunkSize Target chunk size in bytes.
+ * @return False if the file cannot be opened, read or decompressed.
+ */
+bool readChunked(const std::string& path, ChunkConsumer& consumer, size_t chunkSize = 1 << 20);
+
+
+#endif // CHUNKED_READER_H
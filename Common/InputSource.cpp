@@ -0,0 +1,242 @@
+#include "InputSource.h"
+
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef AOC_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef AOC_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+// compressed bytes read from the file per refill
+static const size_t COMPRESSED_BLOCK = 1 << 18;
+
+
+// ================================================================
+//                     PLAIN
+// ================================================================
+
+class PlainSource : public InputSource {
+public:
+
+    explicit PlainSource(int fd) : fd(fd) {
+#ifdef POSIX_FADV_SEQUENTIAL
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    }
+
+    ~PlainSource() override { ::close(fd); }
+
+    long read(char* buffer, size_t size) override {
+
+        // ask the kernel to start on the block after this one
+#ifdef POSIX_FADV_WILLNEED
+        posix_fadvise(fd, offset + (off_t)size, (off_t)size, POSIX_FADV_WILLNEED);
+#endif
+
+        ssize_t n = ::read(fd, buffer, size);
+        if (n < 0) {
+            error = "read failed";
+            return -1;
+        }
+
+        offset += n;
+        return (long)n;
+    }
+
+    int fd;
+    off_t offset = 0;
+};
+
+
+// ================================================================
+//                     GZIP
+// ================================================================
+
+#ifdef AOC_HAVE_ZLIB
+
+class GzipSource : public InputSource {
+public:
+
+    explicit GzipSource(int fd) : fd(fd), input(COMPRESSED_BLOCK) {
+        // 15 + 32: any window size, gzip or zlib header
+        inflateInit2(&stream, 15 + 32);
+    }
+
+    ~GzipSource() override {
+        inflateEnd(&stream);
+        ::close(fd);
+    }
+
+    long read(char* buffer, size_t size) override {
+
+        stream.next_out = reinterpret_cast<Bytef*>(buffer);
+        stream.avail_out = (uInt)size;
+
+        while (stream.avail_out == size) {
+
+            if (stream.avail_in == 0 && !inputEnded) {
+                ssize_t n = ::read(fd, input.data(), input.size());
+                if (n < 0) { error = "read failed"; return -1; }
+                if (n == 0) inputEnded = true;
+                stream.next_in = reinterpret_cast<Bytef*>(input.data());
+                stream.avail_in = (uInt)n;
+            }
+
+            if (stream.avail_in == 0 && inputEnded) {
+                if (!memberEnded) { error = "truncated gzip stream"; return -1; }
+                break;
+            }
+
+            int rc = inflate(&stream, Z_NO_FLUSH);
+
+            if (rc == Z_STREAM_END) {
+                // concatenated members (e.g. "cat a.gz b.gz") continue the stream
+                memberEnded = true;
+                inflateReset(&stream);
+            }
+            else if (rc == Z_OK) {
+                memberEnded = false;
+            }
+            else if (rc != Z_BUF_ERROR) {
+                error = stream.msg ? stream.msg : "corrupt gzip stream";
+                return -1;
+            }
+        }
+
+        return (long)(size - stream.avail_out);
+    }
+
+    int fd;
+    z_stream stream = {};
+    std::vector<char> input;
+    bool inputEnded = false;
+    bool memberEnded = false;
+};
+
+#endif
+
+
+// ================================================================
+//                     ZSTD
+// ================================================================
+
+#ifdef AOC_HAVE_ZSTD
+
+class ZstdSource : public InputSource {
+public:
+
+    explicit ZstdSource(int fd)
+        : fd(fd), context(ZSTD_createDStream()), input(ZSTD_DStreamInSize()) {
+        ZSTD_initDStream(context);
+    }
+
+    ~ZstdSource() override {
+        ZSTD_freeDStream(context);
+        ::close(fd);
+    }
+
+    long read(char* buffer, size_t size) override {
+
+        ZSTD_outBuffer out = { buffer, size, 0 };
+
+        while (out.pos == 0) {
+
+            if (in.pos == in.size && !inputEnded) {
+                ssize_t n = ::read(fd, input.data(), input.size());
+                if (n < 0) { error = "read failed"; return -1; }
+                if (n == 0) inputEnded = true;
+                in = { input.data(), (size_t)n, 0 };
+            }
+
+            if (in.pos == in.size && inputEnded) {
+                if (!frameEnded) { error = "truncated zstd stream"; return -1; }
+                break;
+            }
+
+            size_t rc = ZSTD_decompressStream(context, &out, &in);
+
+            if (ZSTD_isError(rc)) {
+                error = ZSTD_getErrorName(rc);
+                return -1;
+            }
+
+            // 0 = a frame just ended; more frames may follow
+            frameEnded = (rc == 0);
+        }
+
+        return (long)out.pos;
+    }
+
+    int fd;
+    ZSTD_DStream* context;
+    std::vector<char> input;
+    ZSTD_inBuffer in = { nullptr, 0, 0 };
+    bool inputEnded = false;
+    bool frameEnded = true;
+};
+
+#endif
+
+
+// ================================================================
+//                     OPENING
+// ================================================================
+
+InputEncoding detectEncoding(const std::string& path) {
+
+    unsigned char magic[4] = {};
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return InputEncoding::Plain;
+
+    ssize_t n = ::read(fd, magic, sizeof(magic));
+    ::close(fd);
+
+    if (n >= 2 && magic[0] == 0x1f && magic[1] == 0x8b)
+        return InputEncoding::Gzip;
+    if (n >= 4 && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd)
+        return InputEncoding::Zstd;
+
+    return InputEncoding::Plain;
+}
+
+std::unique_ptr<InputSource> openInputSource(const std::string& path, std::string& error) {
+
+    InputEncoding encoding = detectEncoding(path);
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "cannot open " + path;
+        return nullptr;
+    }
+
+    switch (encoding) {
+
+        case InputEncoding::Gzip:
+#ifdef AOC_HAVE_ZLIB
+            return std::make_unique<GzipSource>(fd);
+#else
+            ::close(fd);
+            error = path + " is gzip-compressed, but zlib was not found at build time";
+            return nullptr;
+#endif
+
+        case InputEncoding::Zstd:
+#ifdef AOC_HAVE_ZSTD
+            return std::make_unique<ZstdSource>(fd);
+#else
+            ::close(fd);
+            error = path + " is zstd-compressed, but libzstd was not found at build time";
+            return nullptr;
+#endif
+
+        default:
+            return std::make_unique<PlainSource>(fd);
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef INPUT_SOURCE_H
+#define INPUT_SOURCE_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+
+/**
+ * @brief Encoding of an input file, detected from its first bytes.
+ */
+
+enum class InputEncoding {
+    Plain,
+    Gzip,   ///< 1f 8b
+    Zstd    ///< 28 b5 2f fd
+};
+
+
+/**
+ * @class InputSource
+ * @brief Sequential byte stream over an input file, decompressing on the fly.
+ *
+ * The decompressed bytes are produced in whatever block sizes the codec
+ * yields; the caller (readChunked) cuts them into line-aligned chunks.
+ */
+
+class InputSource {
+public:
+
+    virtual ~InputSource() = default;
+
+    /**
+     * @brief Reads up to 'size' decompressed bytes.
+     *
+     * @return Number of bytes read, 0 at the end of the stream, -1 on error.
+     */
+    virtual long read(char* buffer, size_t size) = 0;
+
+    /** @brief Description of the last error, empty if none. */
+    std::string error;
+};
+
+
+/**
+ * @brief Returns the encoding of a file from its magic bytes.
+ */
+InputEncoding detectEncoding(const std::string& path);
+
+/**
+ * @brief Opens a file as plain, gzip or zstd according to its magic bytes.
+ *
+ * gzip needs zlib and zstd needs libzstd at build time (AOC_HAVE_ZLIB,
+ * AOC_HAVE_ZSTD); without them such files are rejected.
+ *
+ * @param path File to open.
+ * @param error Receives the reason if the file cannot be opened.
+ * @return The source, or nullptr on failure.
+ */
+std::unique_ptr<InputSource> openInputSource(const std::string& path, std::string& error);
+
+
+#endif // INPUT_SOURCE_H
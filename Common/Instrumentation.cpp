@@ -0,0 +1,97 @@
+#include "Instrumentation.h"
+
+#include <fstream>
+#include <iomanip>
+
+Instrumentation& Instrumentation::instance() {
+
+    static Instrumentation shared;
+    return shared;
+}
+
+void Instrumentation::recordTime(const std::string& name, uint64_t nanoseconds) {
+
+    std::lock_guard<std::mutex> lock(timerMutex);
+
+    TimerStats& stats = timers[name];
+    stats.calls++;
+    stats.nanoseconds += nanoseconds;
+}
+
+void Instrumentation::reset() {
+
+    for (std::atomic<uint64_t>& c : counters)
+        c.store(0, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(timerMutex);
+    timers.clear();
+}
+
+const char* Instrumentation::counterName(Counter counter) {
+
+    switch (counter) {
+        case Counter::Day1BytesScanned: return "day1_bytes_scanned";
+        case Counter::Day2DrawsParsed: return "day2_draws_parsed";
+        case Counter::Day3RowProbes: return "day3_row_probes";
+        case Counter::Day4NumbersMatched: return "day4_numbers_matched";
+        case Counter::Day5IntervalSplits: return "day5_interval_splits";
+        default: return "unknown";
+    }
+}
+
+void Instrumentation::writeJson(std::ostream& out) const {
+
+    out << "{\"enabled\":" << (enabled() ? "true" : "false") << ",\"counters\":{";
+
+    for (int i = 0; i < (int)Counter::Count; ++i) {
+        if (i > 0) out << ",";
+        out << "\"" << counterName((Counter)i) << "\":" << value((Counter)i);
+    }
+
+    out << "},\"timers\":{";
+
+    std::lock_guard<std::mutex> lock(timerMutex);
+    bool first = true;
+
+    for (const auto& [name, stats] : timers) {
+        if (!first) out << ",";
+        first = false;
+        out << "\"" << name << "\":{\"calls\":" << stats.calls << ",\"seconds\":"
+            << std::setprecision(9) << stats.nanoseconds * 1e-9 << "}";
+    }
+
+    out << "}}\n";
+}
+
+void Instrumentation::writePrometheus(std::ostream& out) const {
+
+    for (int i = 0; i < (int)Counter::Count; ++i) {
+        std::string metric = std::string("aoc_") + counterName((Counter)i) + "_total";
+        out << "# TYPE " << metric << " counter\n";
+        out << metric << " " << value((Counter)i) << "\n";
+    }
+
+    std::lock_guard<std::mutex> lock(timerMutex);
+
+    out << "# TYPE aoc_phase_seconds_total counter\n";
+    for (const auto& [name, stats] : timers)
+        out << "aoc_phase_seconds_total{phase=\"" << name << "\"} "
+            << std::setprecision(9) << stats.nanoseconds * 1e-9 << "\n";
+
+    out << "# TYPE aoc_phase_calls_total counter\n";
+    for (const auto& [name, stats] : timers)
+        out << "aoc_phase_calls_total{phase=\"" << name << "\"} " << stats.calls << "\n";
+}
+
+bool Instrumentation::writeFile(const std::string& path) const {
+
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) return false;
+
+    bool json = path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0;
+
+    if (json) writeJson(out);
+    else writePrometheus(out);
+
+    return (bool)out;
+}
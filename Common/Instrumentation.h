@@ -0,0 +1,173 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+// Optional hot-path instrumentation.
+//
+// Built with -DAOC_INSTRUMENT=ON (CMake option of the same name) the
+// AOC_COUNT / AOC_SCOPED_TIMER macros record into Instrumentation;
+// otherwise they expand to nothing and their arguments are not evaluated.
+
+
+/**
+ * @brief Work units counted by the solvers.
+ */
+
+enum class Counter : int {
+    Day1BytesScanned,    ///< calibration line bytes examined (Part 1 + Part 2)
+    Day2DrawsParsed,     ///< CubeSets parsed from the input
+    Day3RowProbes,       ///< neighbouring rows searched around a symbol (SchematicGraph::build) or a number
+    Day4NumbersMatched,  ///< played numbers passed to countCardMatches
+    Day5IntervalSplits,  ///< remainder pieces created when a rule cuts an interval (applyMapInArena)
+    Count
+};
+
+/**
+ * @struct TimerStats
+ * @brief Accumulated time of one named phase.
+ */
+
+struct TimerStats {
+    uint64_t calls = 0;
+    uint64_t nanoseconds = 0;
+};
+
+
+/**
+ * @class Instrumentation
+ * @brief Process-wide counters and phase timers.
+ *
+ * Counters are relaxed atomics, so concurrent solver runs can record
+ * into the same instance. Timers are keyed by name behind a mutex and
+ * meant for coarse phases (parse, part 1, part 2), not inner loops.
+ */
+
+class Instrumentation {
+public:
+
+
+    // ================================================================
+    //                     CLASS MEMEBERS
+    // ================================================================
+
+    /** @brief One counter per Counter value. */
+    std::atomic<uint64_t> counters[(int)Counter::Count] = {};
+
+    /** @brief Guards timers. */
+    mutable std::mutex timerMutex;
+    /** @brief Phase timers by name, e.g. "day3.parse". */
+    std::map<std::string, TimerStats> timers;
+
+
+    // ================================================================
+    //                     RECORDING
+    // ================================================================
+
+    /** @brief The process-wide instance used by the macros. */
+    static Instrumentation& instance();
+
+    /** @brief True if the tree was built with AOC_INSTRUMENT. */
+    static constexpr bool enabled() {
+#ifdef AOC_INSTRUMENT
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /** @brief Adds n to a counter. */
+    void add(Counter counter, uint64_t n) {
+        counters[(int)counter].fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /** @brief Current value of a counter. */
+    uint64_t value(Counter counter) const {
+        return counters[(int)counter].load(std::memory_order_relaxed);
+    }
+
+    /** @brief Adds one call of the given duration to a phase timer. */
+    void recordTime(const std::string& name, uint64_t nanoseconds);
+
+    /** @brief Zeroes every counter and drops every timer. */
+    void reset();
+
+    /** @brief Snake-case name of a counter, e.g. "day1_bytes_scanned". */
+    static const char* counterName(Counter counter);
+
+
+    // ================================================================
+    //                     EXPORT
+    // ================================================================
+
+    /**
+     * @brief Writes counters and timers as one JSON object.
+     *
+     * {"enabled":true,"counters":{"day1_bytes_scanned":N,...},
+     *  "timers":{"day1.parse":{"calls":N,"seconds":S},...}}
+     */
+    void writeJson(std::ostream& out) const;
+
+    /**
+     * @brief Writes counters and timers in the Prometheus text format.
+     *
+     * Counters become aoc_<name>_total; timers become
+     * aoc_phase_seconds_total and aoc_phase_calls_total with a
+     * phase="<name>" label.
+     */
+    void writePrometheus(std::ostream& out) const;
+
+    /**
+     * @brief Writes a metrics file, JSON if the path ends in ".json",
+     * Prometheus text otherwise.
+     *
+     * @return False if the file cannot be written.
+     */
+    bool writeFile(const std::string& path) const;
+};
+
+
+/**
+ * @class ScopedTimer
+ * @brief Adds the lifetime of the object to a phase timer.
+ */
+
+class ScopedTimer {
+public:
+
+    explicit ScopedTimer(std::string name)
+        : name(std::move(name)), start(std::chrono::steady_clock::now()) {}
+
+    ~ScopedTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        Instrumentation::instance().recordTime(
+            name, (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    std::string name;
+    std::chrono::steady_clock::time_point start;
+};
+
+
+#define AOC_INSTRUMENT_CONCAT_(a, b) a##b
+#define AOC_INSTRUMENT_CONCAT(a, b) AOC_INSTRUMENT_CONCAT_(a, b)
+
+#ifdef AOC_INSTRUMENT
+#define AOC_COUNT(counter, n) Instrumentation::instance().add(Counter::counter, (uint64_t)(n))
+#define AOC_SCOPED_TIMER(name) ScopedTimer AOC_INSTRUMENT_CONCAT(aocScopedTimer, __LINE__)(name)
+#else
+#define AOC_COUNT(counter, n) ((void)0)
+#define AOC_SCOPED_TIMER(name) ((void)0)
+#endif
+
+
+#endif // INSTRUMENTATION_H
@@ -0,0 +1,91 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include "ChunkedReader.h"
+#include "Instrumentation.h"
+
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+
+/**
+ * @class Solver
+ * @brief CRTP interface shared by the daily solvers.
+ *
+ * A run is split into two phases:
+ *   - parse: input file -> immutable Model, handed out as
+ *     std::shared_ptr<const Model>
+ *   - solve: part1() / part2() on a const Model, any number of times
+ *     and from any number of threads
+ *
+ * A day solver derives from Solver<itself> and provides:
+ *
+ *     typedef ... Model;
+ *     static constexpr int day = N;
+ *     Model parseInput(const std::string& path) const;
+ *     Answer1 solvePart1(const Model& model) const;
+ *     Answer2 solvePart2(const Model& model) const;
+ *
+ * solvePart1/2 must not modify the model; scratch state belongs in
+ * locals or thread_local buffers.
+ *
+ * With AOC_INSTRUMENT each phase is timed as "day<N>.parse",
+ * "day<N>.part1" and "day<N>.part2".
+ */
+
+template <typename Day>
+class Solver {
+public:
+
+    /**
+     * @brief Reads and parses the input file.
+     *
+     * @param path Path to the puzzle input.
+     * @return The parsed model, shareable between threads.
+     * @throws std::runtime_error if the file cannot be opened.
+     */
+    template <typename D = Day>
+    std::shared_ptr<const typename D::Model> parse(const std::string& path) const {
+
+        if (!std::ifstream(path))
+            throw std::runtime_error("cannot open " + path);
+
+        AOC_SCOPED_TIMER("day" + std::to_string(D::day) + ".parse");
+
+        return std::make_shared<const typename D::Model>(self().parseInput(path));
+    }
+
+    /**
+     * @brief Feeds a file to a model through readChunked(), so reading
+     * the next chunk overlaps with parsing the current one.
+     *
+     * @throws std::runtime_error if the file cannot be read.
+     */
+    static void readInput(const std::string& path, ChunkConsumer& model) {
+        if (!readChunked(path, model))
+            throw std::runtime_error("cannot read " + path);
+    }
+
+    /** @brief Solves Part 1 on a parsed model. */
+    template <typename D = Day>
+    auto part1(const typename D::Model& model) const {
+        AOC_SCOPED_TIMER("day" + std::to_string(D::day) + ".part1");
+        return self().solvePart1(model);
+    }
+
+    /** @brief Solves Part 2 on a parsed model. */
+    template <typename D = Day>
+    auto part2(const typename D::Model& model) const {
+        AOC_SCOPED_TIMER("day" + std::to_string(D::day) + ".part2");
+        return self().solvePart2(model);
+    }
+
+private:
+
+    const Day& self() const { return static_cast<const Day&>(*this); }
+};
+
+
+#endif // SOLVER_H
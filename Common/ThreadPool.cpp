@@ -0,0 +1,130 @@
+#include "ThreadPool.h"
+
+#include <stdexcept>
+
+// index of the worker running on this thread, -1 outside the pool
+static thread_local int currentWorker = -1;
+// pool owning currentWorker, so nested pools do not mix up their deques
+static thread_local const ThreadPool* currentPool = nullptr;
+
+
+ThreadPool::ThreadPool(int threadCount) {
+
+    if (threadCount <= 0)
+        threadCount = (int)std::thread::hardware_concurrency();
+    if (threadCount <= 0)
+        threadCount = 1;
+
+    for (int i = 0; i < threadCount; ++i)
+        queues.push_back(std::make_unique<WorkerQueue>());
+
+    for (int i = 0; i < threadCount; ++i)
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+
+    wait();
+
+    {
+        std::lock_guard<std::mutex> lock(idleMutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+
+    for (std::thread& t : workers)
+        t.join();
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+
+    size_t target = (currentPool == this)
+        ? (size_t)currentWorker
+        : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+
+    pending.fetch_add(1);
+
+    // counted before it is published: a worker that takes the task at once
+    // must not decrement queued below zero. Also done before taking
+    // idleMutex, so a worker about to sleep sees it.
+    queued.fetch_add(1);
+
+    {
+        std::lock_guard<std::mutex> lock(queues[target]->mutex);
+        queues[target]->tasks.push_back(std::move(task));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(idleMutex);
+    }
+    workAvailable.notify_one();
+}
+
+void ThreadPool::wait() {
+
+    // pending counts the calling task itself, so it would never reach zero
+    if (currentPool == this)
+        throw std::logic_error("ThreadPool::wait() called from one of its own tasks");
+
+    std::unique_lock<std::mutex> lock(idleMutex);
+    allDone.wait(lock, [this] { return pending.load() == 0; });
+}
+
+bool ThreadPool::tryTake(int worker, std::function<void()>& task) {
+
+    // own deque, newest first
+    {
+        WorkerQueue& own = *queues[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queued.fetch_sub(1);
+            return true;
+        }
+    }
+
+    // steal the oldest task of the next non-empty deque
+    int n = (int)queues.size();
+    for (int k = 1; k < n; ++k) {
+        WorkerQueue& victim = *queues[(worker + k) % n];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queued.fetch_sub(1);
+            steals.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::workerLoop(int worker) {
+
+    currentWorker = worker;
+    currentPool = this;
+
+    std::function<void()> task;
+
+    while (true) {
+
+        if (tryTake(worker, task)) {
+
+            task();
+            task = nullptr;
+
+            if (pending.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(idleMutex);
+                allDone.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(idleMutex);
+        workAvailable.wait(lock, [this] { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0)
+            return;
+    }
+}
@@ -0,0 +1,119 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/**
+ * @class ThreadPool
+ * @brief Fixed-size work-stealing thread pool.
+ *
+ * Every worker owns a deque of tasks:
+ *  - tasks submitted from a worker go to the back of its own deque,
+ *    tasks submitted from outside are dealt round-robin
+ *  - a worker takes its own tasks from the back (most recent first)
+ *  - an idle worker steals from the front of the other deques
+ *
+ * Tasks must not throw; wrap the body in a try/catch if it can.
+ */
+
+class ThreadPool {
+public:
+
+
+    // ================================================================
+    //                     CLASS MEMEBERS
+    // ================================================================
+
+    /** @brief Task deque owned by one worker. */
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    /** @brief One deque per worker. */
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    /** @brief The worker threads. */
+    std::vector<std::thread> workers;
+
+    /** @brief Guards sleeping and waking of workers and waiters. */
+    std::mutex idleMutex;
+    /** @brief Signalled when a task is queued or the pool stops. */
+    std::condition_variable workAvailable;
+    /** @brief Signalled when the last pending task finishes. */
+    std::condition_variable allDone;
+
+    /** @brief Tasks sitting in a deque, not yet taken by a worker. */
+    std::atomic<size_t> queued{0};
+    /** @brief Tasks submitted and not yet finished. */
+    std::atomic<size_t> pending{0};
+    /** @brief Round-robin cursor for tasks submitted from outside. */
+    std::atomic<size_t> nextQueue{0};
+    /** @brief Number of tasks taken from another worker's deque. */
+    std::atomic<long long> steals{0};
+    /** @brief Set by the destructor to end the worker loops. */
+    bool stopping = false;
+
+
+    // ================================================================
+    //                     POOL
+    // ================================================================
+
+    /**
+     * @brief Starts the workers.
+     *
+     * @param threadCount Number of workers, 0 = hardware concurrency.
+     */
+    explicit ThreadPool(int threadCount = 0);
+
+    /** @brief Finishes the queued tasks and joins the workers. */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Queues a task.
+     *
+     * May be called from inside a task; the new task then goes to the
+     * calling worker's own deque.
+     *
+     * @param task Work to run on some worker.
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * @brief Blocks until every submitted task has finished.
+     *
+     * Must not be called from a task of this pool: the caller's own task
+     * is still pending, so the wait could never end.
+     *
+     * @throws std::logic_error if called from one of the pool's workers.
+     */
+    void wait();
+
+    /** @brief Number of workers. */
+    int size() const { return (int)workers.size(); }
+
+    /**
+     * @brief Takes a task for the given worker, stealing if its deque is empty.
+     *
+     * @param worker Index of the calling worker.
+     * @param task Receives the task.
+     * @return False if no deque had a task.
+     */
+    bool tryTake(int worker, std::function<void()>& task);
+
+    /** @brief Main loop of worker 'worker'. */
+    void workerLoop(int worker);
+};
+
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,271 @@
+#ifndef DIGIT_WORD_SCANNER_H
+#define DIGIT_WORD_SCANNER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+
+/**
+ * @struct DigitWord
+ * @brief One spelled-out digit of a vocabulary, e.g. {"seven", 7}.
+ */
+
+struct DigitWord {
+    const char* text;
+    int value;
+};
+
+
+// ================================================================
+//                     VOCABULARIES
+// ================================================================
+//
+// A vocabulary is a type with a static constexpr 'words' array.
+// Words are matched byte for byte (UTF-8 is fine, matching is
+// case-sensitive); numeric digits '0'-'9' are always recognized.
+
+/** @brief The puzzle's vocabulary: "one" ... "nine". */
+struct EnglishDigitWords {
+    static constexpr DigitWord words[] = {
+        {"one", 1}, {"two", 2}, {"three", 3}, {"four", 4}, {"five", 5},
+        {"six", 6}, {"seven", 7}, {"eight", 8}, {"nine", 9}
+    };
+};
+
+/** @brief German digit words, "eins" ... "neun" ("fünf" in UTF-8). */
+struct GermanDigitWords {
+    static constexpr DigitWord words[] = {
+        {"eins", 1}, {"zwei", 2}, {"drei", 3}, {"vier", 4}, {"f\xc3\xbcnf", 5},
+        {"sechs", 6}, {"sieben", 7}, {"acht", 8}, {"neun", 9}
+    };
+};
+
+/** @brief Spanish digit words, "uno" ... "nueve". */
+struct SpanishDigitWords {
+    static constexpr DigitWord words[] = {
+        {"uno", 1}, {"dos", 2}, {"tres", 3}, {"cuatro", 4}, {"cinco", 5},
+        {"seis", 6}, {"siete", 7}, {"ocho", 8}, {"nueve", 9}
+    };
+};
+
+
+// ================================================================
+//                     COMPILE-TIME CONSTRUCTION
+// ================================================================
+
+/** @brief Number of words in a vocabulary. */
+template <typename Vocabulary>
+constexpr size_t digitWordCount() {
+    return sizeof(Vocabulary::words) / sizeof(DigitWord);
+}
+
+/** @brief Upper bound on trie states: one per letter plus the root. */
+template <typename Vocabulary>
+constexpr size_t digitWordStates() {
+
+    size_t n = 1;
+    for (size_t w = 0; w < digitWordCount<Vocabulary>(); ++w)
+        for (const char* p = Vocabulary::words[w].text; *p; ++p)
+            ++n;
+    return n;
+}
+
+/**
+ * @struct DigitWordClasses
+ * @brief Input class of every byte; 0 = byte used by no word.
+ */
+
+struct DigitWordClasses {
+    std::array<uint8_t, 256> of{};
+    size_t count = 1;
+};
+
+template <typename Vocabulary>
+constexpr DigitWordClasses buildDigitWordClasses() {
+
+    DigitWordClasses classes{};
+
+    for (size_t w = 0; w < digitWordCount<Vocabulary>(); ++w)
+        for (const char* p = Vocabulary::words[w].text; *p; ++p) {
+            unsigned char b = (unsigned char)*p;
+            if (classes.of[b] == 0)
+                classes.of[b] = (uint8_t)classes.count++;
+        }
+
+    return classes;
+}
+
+/**
+ * @struct DigitWordTable
+ * @brief Transition table and per-state outputs of the automaton.
+ *
+ * Every state records the longest and the shortest word ending there
+ * (including words reached through failure links): the longest gives
+ * the earliest start of a match ending at a position, the shortest
+ * the latest start.
+ */
+
+template <size_t States, size_t Classes>
+struct DigitWordTable {
+    std::array<std::array<uint16_t, Classes>, States> next{};
+    std::array<int8_t, States> longestValue{};    // -1 = no word ends here
+    std::array<uint8_t, States> longestLength{};
+    std::array<int8_t, States> shortestValue{};
+    std::array<uint8_t, States> shortestLength{};
+};
+
+/** @brief Builds the Aho-Corasick automaton of a vocabulary. */
+template <typename Vocabulary, size_t States, size_t Classes>
+constexpr DigitWordTable<States, Classes> buildDigitWordTable(const DigitWordClasses& classes) {
+
+    DigitWordTable<States, Classes> t{};
+    std::array<uint16_t, States> fail{};
+    std::array<int8_t, States> ownValue{};
+    std::array<uint8_t, States> ownLength{};
+
+    for (size_t s = 0; s < States; ++s) {
+        ownValue[s] = -1;
+        t.longestValue[s] = -1;
+        t.shortestValue[s] = -1;
+    }
+
+    // trie (0 = no child yet; the root is never a child)
+    size_t states = 1;
+
+    for (size_t w = 0; w < digitWordCount<Vocabulary>(); ++w) {
+
+        size_t s = 0;
+        size_t len = 0;
+
+        for (const char* p = Vocabulary::words[w].text; *p; ++p, ++len) {
+            uint8_t c = classes.of[(unsigned char)*p];
+            if (t.next[s][c] == 0)
+                t.next[s][c] = (uint16_t)states++;
+            s = t.next[s][c];
+        }
+
+        // a repeated word keeps its first value
+        if (len > 0 && ownValue[s] < 0) {
+            ownValue[s] = (int8_t)Vocabulary::words[w].value;
+            ownLength[s] = (uint8_t)len;
+        }
+    }
+
+    // breadth-first: failure links, full transitions, outputs
+    std::array<uint16_t, States> queue{};
+    size_t head = 0;
+    size_t tail = 0;
+    queue[tail++] = 0;
+
+    while (head < tail) {
+
+        size_t s = queue[head++];
+        size_t f = fail[s];
+
+        // the own word is the longest output; the failure state holds
+        // the outputs of the proper suffixes, all shorter
+        bool ownOutput = ownValue[s] >= 0 || s == 0;
+        t.longestValue[s] = ownOutput ? ownValue[s] : t.longestValue[f];
+        t.longestLength[s] = ownOutput ? ownLength[s] : t.longestLength[f];
+
+        bool suffixOutput = s != 0 && t.shortestValue[f] >= 0;
+        t.shortestValue[s] = suffixOutput ? t.shortestValue[f] : ownValue[s];
+        t.shortestLength[s] = suffixOutput ? t.shortestLength[f] : ownLength[s];
+
+        for (size_t c = 0; c < Classes; ++c) {
+
+            uint16_t child = t.next[s][c];
+
+            if (child != 0) {
+                fail[child] = (s == 0) ? 0 : t.next[f][c];
+                queue[tail++] = child;
+            }
+            else {
+                t.next[s][c] = (s == 0) ? 0 : t.next[f][c];
+            }
+        }
+    }
+
+    return t;
+}
+
+
+/**
+ * @class DigitWordScanner
+ * @brief Single-pass digit finder with an automaton built at compile time.
+ *
+ * The Aho-Corasick automaton of the vocabulary is computed by constexpr
+ * functions, so each vocabulary gets its own scanner whose tables are
+ * constants in the binary: at run time a line costs one table lookup
+ * per byte, with no string comparisons.
+ *
+ * Bytes that occur in no word share one input class, which keeps the
+ * transition table at (states) x (distinct letters + 1) entries.
+ */
+
+template <typename Vocabulary>
+class DigitWordScanner {
+public:
+
+    static constexpr DigitWordClasses classes = buildDigitWordClasses<Vocabulary>();
+    static constexpr size_t stateCount = digitWordStates<Vocabulary>();
+    static constexpr size_t classCount = classes.count;
+
+    static constexpr DigitWordTable<stateCount, classCount> table =
+        buildDigitWordTable<Vocabulary, stateCount, classCount>(classes);
+
+    static_assert(stateCount < 65536, "vocabulary too large for 16-bit states");
+
+
+    // ================================================================
+    //                     SCANNING
+    // ================================================================
+
+    /**
+     * @brief Calibration value of a line: first digit * 10 + last digit.
+     *
+     * "First" and "last" are the digits (numeric or spelled) with the
+     * smallest and the largest start index; overlapping words such as
+     * "twone" count both.
+     *
+     * @param line The calibration line.
+     * @return The calibration value, 0 if the line has no digit at all.
+     */
+    static int calibrationValue(const std::string& line) {
+
+        int state = 0;
+        int firstValue = -1;
+        int firstStart = (int)line.size();
+        int lastValue = -1;
+        int lastStart = -1;
+
+        for (int i = 0; i < (int)line.size(); ++i) {
+
+            unsigned char b = (unsigned char)line[i];
+
+            if (b >= '0' && b <= '9') {
+                if (i < firstStart) { firstStart = i; firstValue = b - '0'; }
+                if (i > lastStart) { lastStart = i; lastValue = b - '0'; }
+            }
+
+            state = table.next[state][classes.of[b]];
+
+            if (table.longestValue[state] >= 0) {
+
+                int start = i + 1 - table.longestLength[state];
+                if (start < firstStart) { firstStart = start; firstValue = table.longestValue[state]; }
+
+                start = i + 1 - table.shortestLength[state];
+                if (start > lastStart) { lastStart = start; lastValue = table.shortestValue[state]; }
+            }
+        }
+
+        if (firstValue < 0) return 0;
+        return firstValue * 10 + lastValue;
+    }
+};
+
+
+#endif // DIGIT_WORD_SCANNER_H
@@ -0,0 +1,30 @@
+#ifndef WEATHER_CALIBRATION_SOLVER_H
+#define WEATHER_CALIBRATION_SOLVER_H
+
+#include "Solver.h"
+#include "WeatherCalibration.h"
+
+
+/**
+ * @class WeatherCalibrationSolver
+ * @brief Day 1 on the Solver interface; the model is a parsed WeatherCalibration1.
+ */
+
+class WeatherCalibrationSolver : public Solver<WeatherCalibrationSolver> {
+public:
+
+    typedef WeatherCalibration1 Model;
+    static constexpr int day = 1;
+
+    Model parseInput(const std::string& path) const {
+        Model model(path);
+        readInput(path, model);
+        return model;
+    }
+
+    int solvePart1(const Model& model) const { return model.getSolutionPart1(); }
+    int solvePart2(const Model& model) const { return model.getSolutionPart2(); }
+};
+
+
+#endif // WEATHER_CALIBRATION_SOLVER_H
@@ -0,0 +1,59 @@
+#include "DigitWordScanner.h"
+
+#include <cstdio>
+#include <initializer_list>
+#include <string>
+
+using namespace std;
+
+// Checks the compile-time scanner of every vocabulary on lines with
+// overlapping words, multi-byte letters and mixed numeric digits;
+// every word of a vocabulary is the first or the last digit of at
+// least one line, so a wrong entry in any table fails:
+//
+//     wordcheck
+
+struct WordCase {
+    const char* line;
+    int expected;
+};
+
+template <typename Vocabulary>
+static int checkVocabulary(const char* name, std::initializer_list<WordCase> cases) {
+
+    int failures = 0;
+
+    for (const WordCase& c : cases) {
+        int got = DigitWordScanner<Vocabulary>::calibrationValue(c.line);
+        if (got != c.expected) {
+            std::printf("%s: \"%s\" gave %d, expected %d\n", name, c.line, got, c.expected);
+            ++failures;
+        }
+    }
+
+    return failures;
+}
+
+int main() {
+
+    int failures = 0;
+
+    failures += checkVocabulary<EnglishDigitWords>("english", {
+        {"two1nine", 29}, {"xtwone3four", 24}, {"eightwothree", 83}, {"zoneight234", 14},
+        {"7pqrstsixteen", 76}, {"oneight", 18}, {"fiveseven", 57}, {"abc", 0}
+    });
+
+    failures += checkVocabulary<GermanDigitWords>("german", {
+        {"xzweinsf\xc3\xbcnfy", 25}, {"achtzehn", 88}, {"sechsiebenx", 67},
+        {"neunzig4drei", 93}, {"vier0eins", 41}, {"fnf", 0}
+    });
+
+    failures += checkVocabulary<SpanishDigitWords>("spanish", {
+        {"xdoseisietey", 27}, {"cuatrocho", 48}, {"unonueve", 19},
+        {"5tresx", 53}, {"seis1cinco", 65}, {"cincuenta", 0}
+    });
+
+    if (failures) return 1;
+    std::printf("ok\n");
+    return 0;
+}
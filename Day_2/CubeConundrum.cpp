@@ -1,118 +1,336 @@
-#include "CubeConundrum.h"
-
-CubeConundrum::CubeConundrum(const std::string& input) {
-    puzzleInput = input;
-    readPuzzleInput();
-}
-
-void CubeConundrum::readPuzzleInput() {
-
-    // open puzzle input
-    std::ifstream f(puzzleInput);
-    std::string s;
-
-    // read in each line
-    while (std::getline(f, s)) {
-
-        // separate string
-        size_t colonPos = s.find(':');
-        std::string s1 = s.substr(0, colonPos);
-        std::string s2 = s.substr(colonPos + 1);
-
-        Game g;
-        // extract game ID
-        g.id = std::stoi(s1.substr(5));
-
-        std::stringstream sets(s2);
-        std::string setInfo;
-
-        // read game sets
-        while (std::getline(sets, setInfo, ';')) {
-
-            CubeSet set;
-            std::stringstream pairs(setInfo);
-            std::string pairInfo;
-
-            // read set pairs and set color counts
-            while (std::getline(pairs, pairInfo, ',')) {
-
-                std::stringstream ss(pairInfo);
-                int count;
-                std::string color;
-
-                ss >> count >> color;
-
-                if (color == "red") set.red = count;
-                else if (color == "green") set.green = count;
-                else if (color == "blue") set.blue = count;
-            }
-
-            // insert set into game
-            g.cubeSets.push_back(set);
-        }
-
-        // inset game into list
-        games.push_back(g);
-    }
-
-    std::cout << "Read Successful: " << games.size() << " total games read." << std::endl;
-}
-
-int CubeConundrum::getSolutionPart1(bool detail) {
-
-    int solution1 = 0;
-    bool valid = true;
-
-    for (int i = 0; i < (int)games.size(); ++i) {
-        valid = true;
-        for (int j = 0; j < (int) games[i].cubeSets.size(); ++j) {
-
-            if (games[i].cubeSets[j].blue > 14 || games[i].cubeSets[j].red > 12 || games[i].cubeSets[j].green > 13) {
-                valid = false;
-            }
-        }
-
-        if (valid) {
-            if (detail) testPrintGame(i);
-            solution1 += games[i].id;
-        }
-    }
-
-    return solution1;
-}
-
-CubeSet CubeConundrum::minCubesNeeded(const Game& g) {
-
-    CubeSet cs;
-    for (int i = 0; i < (int)g.cubeSets.size(); ++i) {
-        CubeSet curr = g.cubeSets[i];
-        cs.blue = std::max(cs.blue, curr.blue);
-        cs.red = std::max(cs.red, curr.red);
-        cs.green = std::max(cs.green, curr.green);
-    }
-
-    std::cout << "Min: B=" << cs.blue << " R=" << cs.red << " G=" << cs.green << std::endl;
-    return cs;
-}
-
-int CubeConundrum::getSolutionPart2() {
-
-    int solution2 = 0;
-
-    for (int i = 0; i < (int)games.size(); ++i) {
-        CubeSet csMin = minCubesNeeded(games[i]);
-        solution2 += (csMin.blue * csMin.red * csMin.green);
-    }
-    return solution2;
-}
-
-void CubeConundrum::testPrintGame(int pos) {
-
-    Game g = games[pos];
-    std::cout << "Valid Game. ID: " << g.id << "\n";
-
-    for (int i = 0; i < (int)g.cubeSets.size(); ++i) {
-        CubeSet cs = g.cubeSets[i];
-        std::cout << "[Game " << i <<  " R=" << cs.red << " B=" << cs.blue << " G=" << cs.green << "]\n";
-    }
-}
+#include "CubeConundrum.h"
+#include "Instrumentation.h"
+#include "InputSource.h"
+
+#include <stdexcept>
+#include <cerrno>
+#include <limits>
+#include <chrono>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#endif
+
+template <size_t N>
+CubeConundrumN<N>::CubeConundrumN(const std::string& input, bool readInput) {
+
+    static_assert(N >= 3, "red, green and blue need three colors");
+
+    puzzleInput = input;
+
+    // red, green, blue first; further colors are unlimited in Part 1
+    for (size_t c = 0; c < N; ++c) limits.count[c] = std::numeric_limits<int32_t>::max();
+    limits.count[colors.intern("red", N)] = 12;
+    limits.count[colors.intern("green", N)] = 13;
+    limits.count[colors.intern("blue", N)] = 14;
+
+    if (readInput) readPuzzleInput();
+}
+
+template <size_t N>
+void CubeConundrumN<N>::readPuzzleInput() {
+
+    // plain, gzip or zstd; lines arrive through consumeLine()
+    if (!readChunked(puzzleInput, *this))
+        throw std::runtime_error("cannot read " + puzzleInput);
+}
+
+template <size_t N>
+void CubeConundrumN<N>::consumeLine(const std::string& s) {
+
+    Game g;
+    parseGame(s, g);
+
+    // inset game into list
+    games.push_back(g);
+}
+
+template <size_t N>
+void CubeConundrumN<N>::parseGame(const std::string& s, Game& g) {
+
+    // separate string
+    size_t colonPos = s.find(':');
+    std::string s1 = s.substr(0, colonPos);
+    std::string s2 = s.substr(colonPos + 1);
+
+    g.cubeSets.clear();
+    // extract game ID
+    g.id = std::stoi(s1.substr(5));
+
+    std::stringstream sets(s2);
+    std::string setInfo;
+
+    // read game sets
+    while (std::getline(sets, setInfo, ';')) {
+
+        CubeSet set;
+        std::stringstream pairs(setInfo);
+        std::string pairInfo;
+
+        // read set pairs and set color counts
+        while (std::getline(pairs, pairInfo, ',')) {
+
+            std::stringstream ss(pairInfo);
+            int count;
+            std::string color;
+
+            ss >> count >> color;
+
+            if (!color.empty()) set.count[colors.intern(color, N)] = count;
+        }
+
+        // insert set into game
+        g.cubeSets.push_back(set);
+        AOC_COUNT(Day2DrawsParsed, 1);
+    }
+}
+
+template <size_t N>
+void CubeConundrumN<N>::finishInput() {
+
+    std::cout << "Read Successful: " << games.size() << " total games read." << std::endl;
+}
+
+template <size_t N>
+int CubeConundrumN<N>::getSolutionPart1(bool detail) const {
+
+    int solution1 = 0;
+
+    for (int i = 0; i < (int)games.size(); ++i) {
+
+        if (cubeFits(minCubesNeeded(games[i]), limits)) {
+            if (detail) testPrintGame(i);
+            solution1 += games[i].id;
+        }
+    }
+
+    return solution1;
+}
+
+template <size_t N>
+typename CubeConundrumN<N>::CubeSet CubeConundrumN<N>::minCubesNeeded(const Game& g, bool detail) const {
+
+    CubeSet cs;
+    for (int i = 0; i < (int)g.cubeSets.size(); ++i)
+        cs = cubeMax(cs, g.cubeSets[i]);
+
+    if (detail) {
+        std::cout << "Min:";
+        for (size_t c = 0; c < colors.names.size(); ++c)
+            std::cout << " " << colors.names[c] << "=" << cs.count[c];
+        std::cout << std::endl;
+    }
+    return cs;
+}
+
+template <size_t N>
+long long CubeConundrumN<N>::power(const CubeSet& cs) const {
+
+    long long p = 1;
+    for (size_t c = 0; c < N; ++c)
+        if (c < baseColors || cs.count[c] > 0) p *= cs.count[c];
+    return p;
+}
+
+template <size_t N>
+long long CubeConundrumN<N>::getSolutionPart2() const {
+
+    long long solution2 = 0;
+
+    for (int i = 0; i < (int)games.size(); ++i)
+        solution2 += power(minCubesNeeded(games[i]));
+
+    return solution2;
+}
+
+template <size_t N>
+void CubeConundrumN<N>::foldGame(const Game& g, long long& part1, long long& part2) const {
+
+    CubeSet csMin = minCubesNeeded(g);
+
+    if (cubeFits(csMin, limits)) part1 += g.id;
+    part2 += power(csMin);
+}
+
+template <size_t N>
+long long CubeConundrumN<N>::readAppended() {
+
+    if (detectEncoding(puzzleInput) != InputEncoding::Plain) {
+        std::cerr << "Cannot follow a compressed file: " << puzzleInput << std::endl;
+        return -1;
+    }
+
+    int fd = ::open(puzzleInput.c_str(), O_RDONLY | O_CLOEXEC);
+
+    // rotated away and not recreated yet
+    if (fd < 0 && errno == ENOENT && followInode != 0) return 0;
+
+    if (fd < 0) {
+        std::cerr << "Error opening " << puzzleInput << std::endl;
+        return -1;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return -1;
+    }
+
+    // state after this batch; committed only if every line parses
+    size_t offset = followOffset;
+    long long games = followGames;
+    long long part1 = followPart1;
+    long long part2 = followPart2;
+
+    // truncated or replaced: start over
+    if ((size_t)st.st_size < offset || (unsigned long long)st.st_ino != followInode) {
+        offset = 0;
+        games = 0;
+        part1 = 0;
+        part2 = 0;
+    }
+
+    // only the appended bytes are read
+    std::string data((size_t)st.st_size - offset, '\0');
+    size_t got = 0;
+
+    while (got < data.size()) {
+        ssize_t n = ::pread(fd, &data[got], data.size() - got, (off_t)(offset + got));
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) {
+            ::close(fd);
+            std::cerr << "Error reading " << puzzleInput << std::endl;
+            return -1;
+        }
+        if (n == 0) break;
+        got += (size_t)n;
+    }
+    ::close(fd);
+
+    // complete lines only; a partial last line is read again next time
+    size_t end = data.rfind('\n', got == 0 ? 0 : got - 1);
+    if (got == 0 || end == std::string::npos) end = 0;
+    else end++;
+
+    long long added = 0;
+    size_t start = 0;
+    Game g;
+
+    // folded, not stored
+    while (start < end) {
+        size_t nl = data.find('\n', start);
+        if (nl > start) {
+            try {
+                parseGame(data.substr(start, nl - start), g);
+            }
+            catch (const std::exception& e) {
+                std::cerr << "Bad game line at byte " << (offset + start) << " of " << puzzleInput
+                          << ": " << e.what() << std::endl;
+                return -1;
+            }
+            foldGame(g, part1, part2);
+            added++;
+        }
+        start = nl + 1;
+    }
+
+    followOffset = offset + end;
+    followInode = (unsigned long long)st.st_ino;
+    followGames = games + added;
+    followPart1 = part1;
+    followPart2 = part2;
+    return added;
+}
+
+template <size_t N>
+bool CubeConundrumN<N>::follow(const std::function<bool(long long newGames)>& onUpdate, int pollMs) {
+
+    long long added = readAppended();
+    if (added < 0) return false;
+
+#ifdef __linux__
+    const uint32_t mask = IN_MODIFY | IN_CLOSE_WRITE | IN_MOVE_SELF | IN_DELETE_SELF;
+
+    // the directory tells when a rotated file is recreated
+    size_t slash = puzzleInput.rfind('/');
+    std::string directory = slash == std::string::npos ? "." : puzzleInput.substr(0, slash + 1);
+    std::string name = slash == std::string::npos ? puzzleInput : puzzleInput.substr(slash + 1);
+
+    int fd = inotify_init1(IN_CLOEXEC);
+    if (fd < 0 || inotify_add_watch(fd, puzzleInput.c_str(), mask) < 0 ||
+        inotify_add_watch(fd, directory.c_str(), IN_CREATE | IN_MOVED_TO) < 0) {
+        std::cerr << "Cannot watch " << puzzleInput << std::endl;
+        if (fd >= 0) ::close(fd);
+        return false;
+    }
+
+    bool ok = true;
+
+    while (ok && onUpdate(added)) {
+
+        pollfd p{fd, POLLIN, 0};
+        int ready = ::poll(&p, 1, pollMs);
+        if (ready < 0 && errno != EINTR) ok = false;
+
+        // drain the events; readAppended() looks at the file itself
+        if (ok && ready > 0) {
+
+            alignas(inotify_event) char events[4096];
+            ssize_t n = ::read(fd, events, sizeof(events));
+            if (n < 0 && errno != EINTR && errno != EAGAIN) ok = false;
+
+            // rotated: watch the new file once it exists under the same name
+            bool rewatch = false;
+            for (ssize_t i = 0; i < n; ) {
+                const inotify_event* e = (const inotify_event*)(events + i);
+                if (e->mask & (IN_MOVE_SELF | IN_DELETE_SELF | IN_IGNORED)) rewatch = true;
+                if ((e->mask & (IN_CREATE | IN_MOVED_TO)) && e->len > 0 && name == e->name) rewatch = true;
+                i += sizeof(inotify_event) + e->len;
+            }
+            if (rewatch && inotify_add_watch(fd, puzzleInput.c_str(), mask) < 0 && errno != ENOENT) {
+                std::cerr << "Cannot watch " << puzzleInput << std::endl;
+                ok = false;
+            }
+        }
+
+        if (ok) {
+            added = readAppended();
+            ok = added >= 0;
+        }
+    }
+
+    ::close(fd);
+    return ok;
+#else
+    while (onUpdate(added)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(pollMs));
+        added = readAppended();
+        if (added < 0) return false;
+    }
+    return true;
+#endif
+}
+
+template <size_t N>
+void CubeConundrumN<N>::testPrintGame(int pos) const {
+
+    Game g = games[pos];
+    std::cout << "Valid Game. ID: " << g.id << "\n";
+
+    for (int i = 0; i < (int)g.cubeSets.size(); ++i) {
+        CubeSet cs = g.cubeSets[i];
+        std::cout << "[Game " << i;
+        for (size_t c = 0; c < colors.names.size(); ++c)
+            std::cout << " " << colors.names[c] << "=" << cs.count[c];
+        std::cout << "]\n";
+    }
+}
+
+
+template class CubeConundrumN<3>;
+template class CubeConundrumN<16>;
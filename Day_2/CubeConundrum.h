@@ -1,157 +1,292 @@
-#ifndef CUBE_CONUNDRUM_H
-#define CUBE_CONUNDRUM_H
-
-#include <iostream>
-#include <vector>
-#include <string>
-#include <fstream>
-#include <sstream>
-#include <istream>
-
-/**
- * @struct CubeSet
- * @brief Represents a single revealed subset of cubes in a game.
- *
- * Each CubeSet corresponds to one semicolon-separated draw
- * (e.g. "3 red, 4 blue, 2 green").
- *
- * Missing colors are implicitly represented as 0.
- */
-
-struct CubeSet {
-
-    int red = 0;
-    int green = 0;
-    int blue = 0;
-};
-
-/**
- * @struct Game
- * @brief Represents a single game from the puzzle input.
- *
- * A game consists of:
- *  - a unique game ID
- *  - a sequence of CubeSets, each corresponding to one draw
- *
- * CubeSets are independent observations; cubes are returned
- * to the bag after each draw.
- */
-
-struct Game {
-
-    int id;
-    std::vector<CubeSet> cubeSets;
-};
-
-/**
- * @class CubeConundrum
- * @brief Solves Advent of Code 2023 Day 2 (Cube Conundrum).
- *
- * This class handles:
- *  - parsing the puzzle input into structured data
- *  - solving Part 1 (game feasibility under fixed constraints)
- *  - solving Part 2 (minimum required cubes and power computation)
- *
- * Parsing and problem logic are intentionally separated to
- * keep the implementation clear and extensible.
- */
-
-class CubeConundrum {
-public:
-
-
-    // ================================================================
-    //                     CLASS MEMEBERS
-    // ================================================================
-
-    /**
-     * @brief Path to the puzzle input file.
-     */
-    std::string puzzleInput;
-
-    /**
-     * @brief All games parsed from the puzzle input.
-     *
-     * Each entry corresponds to one "Game X: ..." line.
-     */
-    std::vector<Game> games;
-
-
-    // ================================================================
-    //                     PART 1
-    // ================================================================
-
-    /**
-     * @brief Constructs the CubeConundrum solver and reads the input file.
-     *
-     * @param input Path to the puzzle input file.
-     */
-    CubeConundrum(const std::string& input);
-
-    /**
-     * @brief Reads and parses the puzzle input file.
-     *
-     * Converts each input line into a Game object with
-     * its associated CubeSets.
-     *
-     * This method performs only parsing, not validation.
-     */
-    void readPuzzleInput();
-
-    /**
-     * @brief Solves Part 1 of the puzzle.
-     *
-     * Determines which games are possible if the bag
-     * contained at most:
-     *  - 12 red cubes
-     *  - 13 green cubes
-     *  - 14 blue cubes
-     *
-     * A game is valid if all its CubeSets satisfy these limits.
-     *
-     * @param detail If true, prints debug information for valid games.
-     * @return The sum of the IDs of all valid games.
-     */
-    int getSolutionPart1(bool detail = false);
-
-
-
-    // ================================================================
-    //                     PART 2
-    // ================================================================
-
-    /**
-     * @brief Computes the minimum number of cubes required for a game (Part 2).
-     *
-     * For each color, the minimum required count is the maximum
-     * observed count across all CubeSets of the game.
-     *
-     * @param g The game to analyze.
-     * @return A CubeSet representing the minimum required cubes.
-     */
-    CubeSet minCubesNeeded(const Game& g);
-
-    /**
-     * @brief Solves Part 2 of the puzzle.
-     *
-     * For each game:
-     *  - computes the minimum required cubes
-     *  - computes the power of that set
-     *  - sums the powers across all games
-     *
-     * @return The sum of the powers of all minimum cube sets.
-     */
-    int getSolutionPart2();
-
-
-    /**
-     * @brief Prints a game and its cube sets for debugging.
-     *
-     * @param pos Index of the game in the games vector.
-     */
-    void testPrintGame(int pos);
-};
-
-
-
-#endif // CUBE_CONUNDRUM_H
+#ifndef CUBE_CONUNDRUM_H
+#define CUBE_CONUNDRUM_H
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <istream>
+#include <functional>
+
+#include "ChunkedReader.h"
+#include "CubeSet.h"
+
+/**
+ * @struct Game
+ * @brief Represents a single game from the puzzle input.
+ *
+ * A game consists of:
+ *  - a unique game ID
+ *  - a sequence of CubeSets, each corresponding to one draw
+ *
+ * CubeSets are independent observations; cubes are returned
+ * to the bag after each draw.
+ */
+
+template <size_t N>
+struct GameN {
+
+    int id;
+    std::vector<CubeSetN<N>> cubeSets;
+};
+
+/**
+ * @class CubeConundrum
+ * @brief Solves Advent of Code 2023 Day 2 (Cube Conundrum).
+ *
+ * This class handles:
+ *  - parsing the puzzle input into structured data
+ *  - solving Part 1 (game feasibility under fixed constraints)
+ *  - solving Part 2 (minimum required cubes and power computation)
+ *
+ * Parsing and problem logic are intentionally separated to
+ * keep the implementation clear and extensible.
+ *
+ * Colors are not fixed: every color name met while parsing gets the
+ * next dense index of the cube sets, up to N colors. red, green and
+ * blue are always indices 0, 1 and 2.
+ *
+ * @tparam N Maximum number of distinct colors (3 for the puzzle).
+ */
+
+template <size_t N>
+class CubeConundrumN : public LineConsumer {
+public:
+
+    typedef CubeSetN<N> CubeSet;
+    typedef GameN<N> Game;
+
+
+    // ================================================================
+    //                     CLASS MEMEBERS
+    // ================================================================
+
+    /**
+     * @brief Path to the puzzle input file.
+     */
+    std::string puzzleInput;
+
+    /**
+     * @brief All games parsed from the puzzle input.
+     *
+     * Each entry corresponds to one "Game X: ..." line.
+     */
+    std::vector<Game> games;
+
+    /**
+     * @brief Color names and their cube set indices.
+     */
+    ColorDictionary colors;
+
+    /** @brief Colors interned by the constructor: red, green, blue. */
+    static constexpr size_t baseColors = 3;
+
+    /**
+     * @brief Part 1 bag contents: 12 red, 13 green, 14 blue.
+     *
+     * Other colors are unlimited unless set through colors.intern().
+     */
+    CubeSet limits;
+
+    /**
+     * @brief Byte offset just past the last complete line read by
+     * readAppended(); everything before it is folded into the totals.
+     */
+    size_t followOffset = 0;
+
+    /** @brief Inode of the followed file, to notice it being replaced. */
+    unsigned long long followInode = 0;
+
+    /** @brief Number of games folded by readAppended(). */
+    long long followGames = 0;
+
+    /** @brief Running Part 1 total over all games read so far. */
+    long long followPart1 = 0;
+
+    /** @brief Running Part 2 total over all games read so far. */
+    long long followPart2 = 0;
+
+
+    // ================================================================
+    //                     PART 1
+    // ================================================================
+
+    /**
+     * @brief Constructs the CubeConundrum solver and reads the input file.
+     *
+     * @param input Path to the puzzle input file.
+     * @param readInput If false, the file is left for readChunked().
+     * @throws std::runtime_error if readInput and the file cannot be read.
+     */
+    CubeConundrumN(const std::string& input, bool readInput = true);
+
+    /**
+     * @brief Reads and parses the puzzle input file.
+     *
+     * Converts each input line into a Game object with
+     * its associated CubeSets.
+     *
+     * This method performs only parsing, not validation.
+     *
+     * The file may be gzip or zstd compressed (see readChunked()).
+     *
+     * @throws std::runtime_error if the file cannot be read or decompressed.
+     */
+    void readPuzzleInput();
+
+    /**
+     * @brief Parses one input line (LineConsumer) and stores the game.
+     *
+     * Called by readChunked() for every line of the input.
+     *
+     * @throws std::runtime_error if the line has more than N colors.
+     */
+    void consumeLine(const std::string& line) override;
+
+    /**
+     * @brief Parses one "Game id: ..." line into g, interning new colors.
+     *
+     * @throws std::runtime_error if the line has more than N colors.
+     */
+    void parseGame(const std::string& line, Game& g);
+
+    /** @brief Reports the number of games read. */
+    void finishInput() override;
+
+    /**
+     * @brief Solves Part 1 of the puzzle.
+     *
+     * Determines which games are possible if the bag
+     * contained at most:
+     *  - 12 red cubes
+     *  - 13 green cubes
+     *  - 14 blue cubes
+     *
+     * A game is valid if all its CubeSets satisfy these limits,
+     * i.e. if its minimum cube set fits into the limits.
+     *
+     * @param detail If true, prints debug information for valid games.
+     * @return The sum of the IDs of all valid games.
+     */
+    int getSolutionPart1(bool detail = false) const;
+
+
+
+    // ================================================================
+    //                     PART 2
+    // ================================================================
+
+    /**
+     * @brief Computes the minimum number of cubes required for a game (Part 2).
+     *
+     * For each color, the minimum required count is the maximum
+     * observed count across all CubeSets of the game, taken lane-wise
+     * with cubeMax().
+     *
+     * @param g The game to analyze.
+     * @param detail If true, prints the minimum cube counts.
+     * @return A CubeSet representing the minimum required cubes.
+     */
+    CubeSet minCubesNeeded(const Game& g, bool detail = false) const;
+
+    /**
+     * @brief Power of a cube set.
+     *
+     * The product of the red, green and blue counts (a missing one
+     * makes the power 0), times the count of every further color the
+     * set itself contains. The result depends only on the set, not on
+     * which colors other games introduced, so batch and follow mode
+     * agree whatever the line order.
+     */
+    long long power(const CubeSet& cs) const;
+
+    /**
+     * @brief Solves Part 2 of the puzzle.
+     *
+     * For each game:
+     *  - computes the minimum required cubes
+     *  - computes the power of that set
+     *  - sums the powers across all games
+     *
+     * @return The sum of the powers of all minimum cube sets.
+     */
+    long long getSolutionPart2() const;
+
+
+
+
+    // ================================================================
+    //                     FOLLOW MODE
+    // ================================================================
+
+    /**
+     * @brief Adds a game's Part 1 and Part 2 contributions to a pair
+     * of totals.
+     */
+    void foldGame(const Game& g, long long& part1, long long& part2) const;
+
+    /**
+     * @brief Parses the complete lines appended since the last call.
+     *
+     * Reads from followOffset to the end of the file, parses every
+     * complete line and folds it into followPart1 and followPart2.
+     * The games are not stored, so memory stays constant however long
+     * the file grows. A trailing line without '\n' is left for the next
+     * call. If the file was replaced or shrank below followOffset
+     * (truncated), the totals are reset and the file is read from the
+     * start.
+     *
+     * Only plain-text files can be followed. Once following, a missing
+     * file (rotated away, not yet recreated) reads as no new games.
+     *
+     * The lines are folded into local totals first. The totals,
+     * followGames and followOffset change together, only once every
+     * line parsed, so a bad line leaves them as they were.
+     *
+     * @return The number of new games, or -1 if the file cannot be read
+     *         or a line is not a valid game.
+     */
+    long long readAppended();
+
+    /**
+     * @brief Follows the input file like "tail -f".
+     *
+     * Reads the current contents, then sleeps on inotify until the file
+     * changes and calls readAppended() again, so keeping up costs time
+     * proportional to the appended data. Without inotify the file is
+     * polled every pollMs milliseconds.
+     *
+     * The parent directory is watched as well: when the file is moved
+     * or deleted (log rotation), the watch moves to the new file as soon
+     * as one is created under the same name.
+     *
+     * @param onUpdate Called after every wakeup with the number of new
+     *        games (0 on timeout); follow() returns when it returns false.
+     * @param pollMs Longest sleep between two calls of onUpdate.
+     * @return False if the file cannot be read or watched.
+     */
+    bool follow(const std::function<bool(long long newGames)>& onUpdate, int pollMs = 1000);
+
+
+    /**
+     * @brief Prints a game and its cube sets for debugging.
+     *
+     * @param pos Index of the game in the games vector.
+     */
+    void testPrintGame(int pos) const;
+};
+
+
+
+/** @brief The puzzle's three colors. */
+typedef CubeConundrumN<3> CubeConundrum;
+
+/** @brief The up-to-16-color variant of the game logs. */
+typedef CubeConundrumN<16> CubeConundrum16;
+
+extern template class CubeConundrumN<3>;
+extern template class CubeConundrumN<16>;
+
+
+#endif // CUBE_CONUNDRUM_H
@@ -0,0 +1,30 @@
+#ifndef CUBE_CONUNDRUM_SOLVER_H
+#define CUBE_CONUNDRUM_SOLVER_H
+
+#include "Solver.h"
+#include "CubeConundrum.h"
+
+
+/**
+ * @class CubeConundrumSolver
+ * @brief Day 2 on the Solver interface; the model is a parsed CubeConundrum.
+ */
+
+class CubeConundrumSolver : public Solver<CubeConundrumSolver> {
+public:
+
+    typedef CubeConundrum Model;
+    static constexpr int day = 2;
+
+    Model parseInput(const std::string& path) const {
+        Model model(path, false);
+        readInput(path, model);
+        return model;
+    }
+
+    int solvePart1(const Model& model) const { return model.getSolutionPart1(); }
+    long long solvePart2(const Model& model) const { return model.getSolutionPart2(); }
+};
+
+
+#endif // CUBE_CONUNDRUM_SOLVER_H
@@ -0,0 +1,163 @@
+#ifndef CUBE_SET_H
+#define CUBE_SET_H
+
+#include <array>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__AVX512F__) || defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+
+/**
+ * @struct CubeSetN
+ * @brief Represents a single revealed subset of cubes in a game.
+ *
+ * Each CubeSet corresponds to one semicolon-separated draw
+ * (e.g. "3 red, 4 blue, 2 green"), with one 32-bit count per color.
+ * Colors are the dense indices handed out by a ColorDictionary.
+ *
+ * Missing colors are implicitly represented as 0. The counts are
+ * padded with zero lanes to a multiple of 4, so that every lane-wise
+ * operation works on whole SIMD registers.
+ *
+ * @tparam N Maximum number of distinct colors.
+ */
+
+template <size_t N>
+struct CubeSetN {
+
+    static_assert(N > 0, "a cube set needs at least one color");
+
+    static constexpr size_t colors = N;
+    static constexpr size_t lanes = (N + 3) / 4 * 4;
+
+    alignas(16) std::array<int32_t, lanes> count{};
+};
+
+
+// ================================================================
+//                     LANE-WISE OPERATIONS
+// ================================================================
+//
+//   - AVX-512: up to 16 lanes per masked operation
+//   - AVX2:    8 lanes, then SSE4.1 for a 4-lane tail
+//   - SSE4.1:  4 lanes
+//
+// Without any of them, the plain loops below do the work.
+
+/** @brief Lane-wise maximum of two cube sets. */
+template <size_t N>
+inline CubeSetN<N> cubeMax(const CubeSetN<N>& a, const CubeSetN<N>& b) {
+
+    constexpr size_t lanes = CubeSetN<N>::lanes;
+    CubeSetN<N> r;
+    size_t i = 0;
+
+#if defined(__AVX512F__)
+    for (; i < lanes; i += 16) {
+        __mmask16 m = (lanes - i >= 16) ? (__mmask16)0xFFFF : (__mmask16)((1u << (lanes - i)) - 1);
+        __m512i va = _mm512_maskz_loadu_epi32(m, &a.count[i]);
+        __m512i vb = _mm512_maskz_loadu_epi32(m, &b.count[i]);
+        _mm512_mask_storeu_epi32(&r.count[i], m, _mm512_maskz_max_epi32(m, va, vb));
+    }
+#elif defined(__AVX2__)
+    for (; i + 8 <= lanes; i += 8) {
+        __m256i va = _mm256_loadu_si256((const __m256i*)&a.count[i]);
+        __m256i vb = _mm256_loadu_si256((const __m256i*)&b.count[i]);
+        _mm256_storeu_si256((__m256i*)&r.count[i], _mm256_max_epi32(va, vb));
+    }
+#endif
+#if defined(__SSE4_1__)
+    for (; i + 4 <= lanes; i += 4) {
+        __m128i va = _mm_loadu_si128((const __m128i*)&a.count[i]);
+        __m128i vb = _mm_loadu_si128((const __m128i*)&b.count[i]);
+        _mm_storeu_si128((__m128i*)&r.count[i], _mm_max_epi32(va, vb));
+    }
+#endif
+    for (; i < lanes; ++i)
+        r.count[i] = std::max(a.count[i], b.count[i]);
+
+    return r;
+}
+
+/** @brief True if no lane of a exceeds the same lane of limit. */
+template <size_t N>
+inline bool cubeFits(const CubeSetN<N>& a, const CubeSetN<N>& limit) {
+
+    constexpr size_t lanes = CubeSetN<N>::lanes;
+    size_t i = 0;
+
+#if defined(__AVX512F__)
+    for (; i < lanes; i += 16) {
+        __mmask16 m = (lanes - i >= 16) ? (__mmask16)0xFFFF : (__mmask16)((1u << (lanes - i)) - 1);
+        __m512i va = _mm512_maskz_loadu_epi32(m, &a.count[i]);
+        __m512i vl = _mm512_maskz_loadu_epi32(m, &limit.count[i]);
+        if (_mm512_mask_cmpgt_epi32_mask(m, va, vl)) return false;
+    }
+#elif defined(__AVX2__)
+    for (; i + 8 <= lanes; i += 8) {
+        __m256i va = _mm256_loadu_si256((const __m256i*)&a.count[i]);
+        __m256i vl = _mm256_loadu_si256((const __m256i*)&limit.count[i]);
+        if (_mm256_movemask_epi8(_mm256_cmpgt_epi32(va, vl))) return false;
+    }
+#endif
+#if defined(__SSE4_1__)
+    for (; i + 4 <= lanes; i += 4) {
+        __m128i va = _mm_loadu_si128((const __m128i*)&a.count[i]);
+        __m128i vl = _mm_loadu_si128((const __m128i*)&limit.count[i]);
+        if (_mm_movemask_epi8(_mm_cmpgt_epi32(va, vl))) return false;
+    }
+#endif
+    for (; i < lanes; ++i)
+        if (a.count[i] > limit.count[i]) return false;
+
+    return true;
+}
+
+
+/**
+ * @struct ColorDictionary
+ * @brief Maps color names to dense indices, resolved while parsing.
+ *
+ * Indices are handed out in order of first appearance. With at most
+ * 16 short names a linear scan beats hashing.
+ */
+
+struct ColorDictionary {
+
+    std::vector<std::string> names;
+
+    /** @brief Index of a color, or -1 if it has not been seen. */
+    int indexOf(const std::string& color) const {
+        for (size_t i = 0; i < names.size(); ++i)
+            if (names[i] == color) return (int)i;
+        return -1;
+    }
+
+    /**
+     * @brief Index of a color, adding it if it is new.
+     *
+     * @param capacity Number of colors a cube set can hold.
+     * @throws std::runtime_error if the color would exceed capacity.
+     */
+    int intern(const std::string& color, size_t capacity) {
+
+        int index = indexOf(color);
+        if (index >= 0) return index;
+
+        if (names.size() >= capacity)
+            throw std::runtime_error("more than " + std::to_string(capacity) + " cube colors: " + color);
+
+        names.push_back(color);
+        return (int)names.size() - 1;
+    }
+};
+
+
+#endif // CUBE_SET_H
@@ -0,0 +1,147 @@
+#include "CubeConundrum.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+using namespace std;
+
+// Checks follow mode against a full parse of the same file:
+//
+//     followcheck [scratch file]
+//
+// Games are appended in batches, with new colors first appearing
+// halfway through and a partial line left at the end of some batches.
+// Then the file is rotated under a running follow(), which must pick
+// up the new file once it is created. Last, a batch with a bad line
+// must fail without counting any of its games.
+
+// one game line; later games draw extra colors
+static std::string gameLine(int id) {
+
+    std::string line = "Game " + std::to_string(id) + ": ";
+    line += std::to_string(1 + id % 7) + " red, " + std::to_string(2 + id % 5) + " green";
+    if (id % 4 != 0) line += ", " + std::to_string(1 + id % 11) + " blue";
+    line += "; " + std::to_string(id % 15) + " red";
+    if (id >= 20) line += ", " + std::to_string(1 + id % 3) + " purple";
+    if (id >= 30 && id % 2 == 0) line += "; " + std::to_string(2 + id % 4) + " teal";
+    return line;
+}
+
+int main(int argc, char* argv[]) {
+
+    std::string path = argc > 1 ? argv[1] : "followcheck.txt";
+    std::ofstream(path, std::ios::trunc).close();
+
+    CubeConundrum16 log(path, false);
+    int next = 1;
+
+    for (int batch = 0; batch < 8; ++batch) {
+
+        std::string pending;
+        {
+            std::ofstream out(path, std::ios::app);
+            for (int i = 0; i < 6; ++i) out << gameLine(next++) << "\n";
+
+            // half a line: must wait for its newline
+            if (batch % 2 == 0) {
+                pending = gameLine(next++);
+                out << pending.substr(0, pending.size() / 2);
+            }
+        }
+
+        if (log.readAppended() < 0) return 1;
+
+        if (!pending.empty()) {
+            std::ofstream(path, std::ios::app) << pending.substr(pending.size() / 2) << "\n";
+            if (log.readAppended() < 0) return 1;
+        }
+
+        CubeConundrum16 full(path);
+        long long expected1 = full.getSolutionPart1();
+        long long expected2 = full.getSolutionPart2();
+
+        if (log.followPart1 != expected1 || log.followPart2 != expected2) {
+            std::cerr << "Follow mismatch after " << next - 1 << " games: Part 1 " << log.followPart1
+                      << " vs " << expected1 << ", Part 2 " << log.followPart2 << " vs " << expected2 << std::endl;
+            return 1;
+        }
+    }
+
+    // rotation: move the file away, recreate it a little later
+    std::string rotated = path + ".1";
+    unsigned long long oldInode = log.followInode;
+    std::atomic<bool> started(false), finished(false), stop(false), rotatedSeen(false);
+    std::atomic<long long> rotated1(0), rotated2(0);
+    bool followed = true;
+
+    std::thread follower([&]() {
+        followed = log.follow([&](long long) {
+            started = true;
+            if (log.followInode != oldInode && log.followGames == 5) {
+                rotated1 = log.followPart1;
+                rotated2 = log.followPart2;
+                rotatedSeen = true;
+            }
+            return !stop && !rotatedSeen;
+        }, 50);
+        finished = true;
+    });
+
+    while (!started && !finished)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    std::rename(path.c_str(), rotated.c_str());
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    {
+        std::ofstream out(path, std::ios::trunc);
+        for (int i = 0; i < 5; ++i) out << gameLine(next++) << "\n";
+    }
+
+    for (int wait = 0; wait < 100 && !rotatedSeen; ++wait)
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    stop = true;
+    follower.join();
+
+    CubeConundrum16 full(path);
+    std::remove(rotated.c_str());
+
+    if (!followed || !rotatedSeen || rotated1 != full.getSolutionPart1() || rotated2 != full.getSolutionPart2()) {
+        std::cerr << "Follow did not pick up the rotated file" << std::endl;
+        return 1;
+    }
+
+    // a bad line fails the whole batch and leaves the totals alone
+    size_t offset = log.followOffset;
+    long long games = log.followGames, part1 = log.followPart1, part2 = log.followPart2;
+    {
+        std::ofstream out(path, std::ios::app);
+        out << gameLine(next) << "\n" << "Game x: 1 red" << "\n" << gameLine(next + 1) << "\n";
+    }
+
+    if (log.readAppended() != -1 || log.followOffset != offset || log.followGames != games ||
+        log.followPart1 != part1 || log.followPart2 != part2) {
+        std::cerr << "A bad line changed the follow totals" << std::endl;
+        return 1;
+    }
+
+    // once the line is fixed, the batch is counted exactly once
+    {
+        std::fstream file(path, std::ios::in | std::ios::out);
+        file.seekp((std::streamoff)(offset + gameLine(next).size() + 1));
+        file << "Game 9: 1 red";
+    }
+
+    CubeConundrum16 fixed(path);
+    if (log.readAppended() != 3 || log.followPart1 != fixed.getSolutionPart1() ||
+        log.followPart2 != fixed.getSolutionPart2()) {
+        std::cerr << "Follow totals wrong after fixing a bad line" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Follow totals match a full parse: " << log.followPart1 << ", " << log.followPart2 << std::endl;
+    std::remove(path.c_str());
+    return 0;
+}
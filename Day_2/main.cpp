@@ -1,20 +1,49 @@
-#include "CubeConundrum.cpp"
-
-using namespace std;
-
-int main() {
-
-    std::cout << "AoC 2023 Day 2" << std::endl;
-
-    CubeConundrum cubeGame("input.txt");
-
-    int solution1 = cubeGame.getSolutionPart1();
-    std::cout << "Part 1 Solution: " << solution1 << std::endl;
-
-    std::cout << "\n--- Part 2 ---" << std::endl;
-    int solution2 = cubeGame.getSolutionPart2();
-    std::cout << "Part 2 Solution: " << solution2 << std::endl;
-
-    return 0;
-}
-
+#include "CubeConundrum.h"
+
+using namespace std;
+
+int main(int argc, char** argv) {
+
+    std::cout << "AoC 2023 Day 2" << std::endl;
+
+    // day2 --follow [file]: keep the totals up to date as the log grows
+    if (argc > 1 && std::string(argv[1]) == "--follow") {
+
+        CubeConundrum log(argc > 2 ? argv[2] : "input.txt", false);
+
+        bool ok = false;
+        try {
+            ok = log.follow([&](long long newGames) {
+                if (newGames > 0)
+                    std::cout << log.followGames << " games: Part 1 = " << log.followPart1
+                              << ", Part 2 = " << log.followPart2 << std::endl;
+                return true;
+            });
+        }
+        catch (const std::exception& e) {
+            std::cerr << "error: " << e.what() << std::endl;
+            return 1;
+        }
+
+        return ok ? 0 : 1;
+    }
+
+    CubeConundrum cubeGame("input.txt", false);
+    try {
+        cubeGame.readPuzzleInput();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    int solution1 = cubeGame.getSolutionPart1();
+    std::cout << "Part 1 Solution: " << solution1 << std::endl;
+
+    std::cout << "\n--- Part 2 ---" << std::endl;
+    long long solution2 = cubeGame.getSolutionPart2();
+    std::cout << "Part 2 Solution: " << solution2 << std::endl;
+
+    return 0;
+}
+
@@ -1,170 +1,320 @@
-#include "GearRatios.h"
-
-#include <fstream>
-
-GearRatios::GearRatios(const std::string& input) {
-    puzzleInput = input;
-}
-
-void GearRatios::readPuzzleInput() {
-
-    std::ifstream f(puzzleInput);
-    std::string str;
-
-    while (std::getline(f, str)) {
-        schematic.push_back(str);
-    }
-
-    std::cout << "Read " << schematic.size() << " lines" << std::endl;
-    std::cout << "Puzzle input successfully read!" << std::endl;
-
-    f.close();
-}
-
-void GearRatios::parseSchematicLine(int ind, bool detail) {
-
-    std::string line = schematic[ind];
-    int len = line.size();
-
-    int pos = 0;
-
-    while (pos < len) {
-
-        if (std::isdigit(line[pos])) {
-            int val = 0;
-            int left = pos;
-
-            while (pos < len && std::isdigit(line[pos])) {
-                val = val * 10 + (line[pos] - '0');
-                pos++;
-            }
-
-            int right = pos -1;
-
-            Number num;
-            num.value = val;
-            num.row = ind;
-            num.colStart = left;
-            num.colEnd = right;
-            numbers.push_back(num);
-
-            if (detail) {
-                std::cout << "Line: " << ind << ", ";
-                num.printNumber();
-            }
-        }
-
-        else {
-
-            if (line[pos] != '.') {
-                Symbol symb;
-                symb.type = line[pos];
-                symb.row = ind;
-                symb.col = pos;
-                symbols.push_back(symb);
-
-                if (detail) {
-                    std::cout << "Line: " << ind << ", ";
-                    symb.printSymbol();
-                }
-            }
-
-            pos++;
-        }
-    }
-}
-
-void GearRatios::parseFullSchematic(bool detail) {
-
-    for (int i = 0; i < (int)schematic.size(); ++i) {
-        parseSchematicLine(i, detail);
-    }
-
-    //if (detail)
-
-    std::cout << "Total numbers parsed: " << numbers.size() << std::endl;
-    std::cout << "Total symbols parsed: " << symbols.size() << std::endl;
-}
-
-bool GearRatios::isPartNumber(int n, bool detail) {
-
-    Number num = numbers[n];
-    if (detail) num.printNumber();
-
-    int r0 = num.row - 1;
-    int r1 = num.row + 1;
-    int c0 = num.colStart - 1;
-    int c1 = num.colEnd + 1;
-
-    for (const Symbol& s : symbols) {
-        if (s.row >= r0 && s.row <= r1 && s.col >= c0 && s.col <= c1) {
-            if (detail) std::cout << "Symbol " << s.type << " touces number " << num.value << "\n";
-            return true;
-        }
-    }
-    return false;
-}
-
-int GearRatios::getSolutionPart1() {
-
-    int sum = 0;
-    for (int i = 0; i < (int)numbers.size(); ++i) {
-        if (isPartNumber(i, false)) sum += numbers[i].value;
-    }
-    return sum;
-}
-
-int GearRatios::isTouchingTwoNumbers(int n, bool detail) {
-
-    Symbol s = symbols[n];
-    if (detail) s.printSymbol();
-
-    int ratio = 1;
-    int count = 0;
-
-    int r0 = s.row - 1;
-    int r1 = s.row + 1;
-    int c0 = s.col - 1;
-    int c1 = s.col + 1;
-
-    for (const Number& num : numbers) {
-
-        if (num.row >= r0 && num.row <= r1 &&
-            num.colEnd >= c0 && num.colStart <= c1) {
-
-            if (detail)
-                std::cout << "Number " << num.value << " touches * symbls\n";
-
-            count++;
-            ratio *= num.value;
-        }
-    }
-    if (count == 2) {
-        if (detail)
-            std::cout << "Found valid gear at ("
-                      << s.row << ", " << s.col << ")\n";
-        return ratio;
-    }
-
-    return -1;
-}
-
-int GearRatios::getSolutionPart2() {
-
-    int sum = 0;
-
-    for (int i = 0; i < (int)symbols.size(); ++i) {
-
-        if (symbols[i].type == '*') {
-            int ratio = isTouchingTwoNumbers(i, false);
-
-            if (ratio > 0)
-                sum += ratio;
-        }
-    }
-
-    return sum;
-}
-
-
-
+#include "GearRatios.h"
+#include "Instrumentation.h"
+
+#include <stdexcept>
+#include <fstream>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX512BW__) || defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+
+// ================================================================
+//                     CELL CLASSIFICATION
+// ================================================================
+//
+// 64 cells at a time into bit masks (bit i = cell i):
+//   - digits:  '0'-'9', as (unsigned)(c - '0') <= 9
+//   - symbols: neither a digit nor '.'
+//
+//   - AVX-512BW: one 64-byte compare per mask
+//   - AVX2:      two 32-byte halves
+//   - SSE2:      four 16-byte quarters
+//
+// Without any of them, the masks are built one cell at a time.
+
+#if defined(__AVX512BW__)
+
+static inline void classifyCells(const char* p, uint64_t& digits, uint64_t& symbols) {
+
+    __m512i v = _mm512_loadu_si512(p);
+    uint64_t d = _mm512_cmple_epu8_mask(_mm512_sub_epi8(v, _mm512_set1_epi8('0')), _mm512_set1_epi8(9));
+    uint64_t dots = _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8('.'));
+
+    digits = d;
+    symbols = ~(d | dots);
+}
+
+#elif defined(__AVX2__)
+
+static inline void classifyCells(const char* p, uint64_t& digits, uint64_t& symbols) {
+
+    uint64_t d = 0;
+    uint64_t dots = 0;
+
+    for (int half = 0; half < 2; ++half) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(p + 32 * half));
+        __m256i x = _mm256_sub_epi8(v, _mm256_set1_epi8('0'));
+        __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(x, _mm256_set1_epi8(9)), x);
+        __m256i isDot = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('.'));
+        d |= (uint64_t)(uint32_t)_mm256_movemask_epi8(isDigit) << (32 * half);
+        dots |= (uint64_t)(uint32_t)_mm256_movemask_epi8(isDot) << (32 * half);
+    }
+
+    digits = d;
+    symbols = ~(d | dots);
+}
+
+#elif defined(__SSE2__)
+
+static inline void classifyCells(const char* p, uint64_t& digits, uint64_t& symbols) {
+
+    uint64_t d = 0;
+    uint64_t dots = 0;
+
+    for (int quarter = 0; quarter < 4; ++quarter) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(p + 16 * quarter));
+        __m128i x = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+        __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(x, _mm_set1_epi8(9)), x);
+        __m128i isDot = _mm_cmpeq_epi8(v, _mm_set1_epi8('.'));
+        d |= (uint64_t)(uint16_t)_mm_movemask_epi8(isDigit) << (16 * quarter);
+        dots |= (uint64_t)(uint16_t)_mm_movemask_epi8(isDot) << (16 * quarter);
+    }
+
+    digits = d;
+    symbols = ~(d | dots);
+}
+
+#else
+
+static inline void classifyCells(const char* p, uint64_t& digits, uint64_t& symbols) {
+
+    digits = 0;
+    symbols = 0;
+
+    for (int i = 0; i < 64; ++i) {
+        unsigned char c = (unsigned char)p[i];
+        if ((unsigned char)(c - '0') <= 9) digits |= 1ULL << i;
+        else if (c != '.') symbols |= 1ULL << i;
+    }
+}
+
+#endif
+
+static inline int popcount64(uint64_t x) { return __builtin_popcountll(x); }
+static inline int countTrailingZeros64(uint64_t x) { return __builtin_ctzll(x); }
+
+/**
+ * @brief Value of 1-8 ASCII digits, decoded in one 64-bit word.
+ *
+ * The digits are shifted to the top bytes (leading zeros below), then
+ * pairs, quads and octets are combined with three multiplies
+ * (little-endian). Reads 8 bytes; the grid padding makes that safe.
+ */
+static inline int decodeDigits(const char* p, int width) {
+
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+
+    // bytes past the digits may borrow upwards, but are shifted out
+    v = (v - 0x3030303030303030ULL) << (8 * (8 - width));
+    v = (v * 10 + (v >> 8)) & 0x00FF00FF00FF00FFULL;
+    v = (v * 100 + (v >> 16)) & 0x0000FFFF0000FFFFULL;
+    v = (v * 10000 + (v >> 32)) & 0x00000000FFFFFFFFULL;
+    return (int)v;
+}
+
+GearRatios::GearRatios(const std::string& input) {
+    puzzleInput = input;
+}
+
+void GearRatios::readPuzzleInput() {
+
+    if (readMapped()) return;
+
+    // plain, gzip or zstd; lines arrive through consumeLine()
+    if (!readChunked(puzzleInput, *this))
+        throw std::runtime_error("cannot read " + puzzleInput);
+}
+
+bool GearRatios::readMapped() {
+
+    if (!schematic.loadMapped(puzzleInput)) return false;
+
+    finishInput();
+    return true;
+}
+
+void GearRatios::consumeLine(const std::string& line) {
+    schematic.appendRow(line);
+}
+
+void GearRatios::finishInput() {
+
+    std::cout << "Read " << schematic.rows << " lines" << std::endl;
+    std::cout << "Puzzle input successfully read!" << std::endl;
+}
+
+void GearRatios::parseSchematicLine(int ind, bool detail) {
+
+    const char* line = schematic.row(ind);
+    int len = schematic.cols;
+
+    uint64_t digitBefore = 0;   // was the cell left of this block a digit
+
+    for (int base = 0; base < len; base += 64) {
+
+        // the grid padding keeps the load in bounds; cells past the row are masked off
+        uint64_t digits, symbolCells;
+        classifyCells(line + base, digits, symbolCells);
+
+        if (len - base < 64) {
+            uint64_t inRow = (1ULL << (len - base)) - 1;
+            digits &= inRow;
+            symbolCells &= inRow;
+        }
+
+        // a number starts where a digit follows a non-digit
+        uint64_t starts = digits & ~((digits << 1) | digitBefore);
+        digitBefore = digits >> 63;
+
+        size_t n = numbers.size();
+        numbers.resize(n + popcount64(starts));
+
+        for (; starts; starts &= starts - 1, ++n) {
+
+            int bit = countTrailingZeros64(starts);
+            int left = base + bit;
+            int width = countTrailingZeros64(~(digits >> bit));   // stops at the block end
+            int val = 0;
+
+            if (width <= 8 && bit + width < 64) {
+                val = decodeDigits(line + left, width);
+            }
+            else {
+                // long or crossing into the next block; the '.' border ends it
+                width = 0;
+                while ((unsigned char)(line[left + width] - '0') <= 9) {
+                    val = val * 10 + (line[left + width] - '0');
+                    width++;
+                }
+            }
+
+            Number& num = numbers[n];
+            num.value = val;
+            num.row = ind;
+            num.colStart = left;
+            num.colEnd = left + width - 1;
+
+            if (detail) {
+                std::cout << "Line: " << ind << ", ";
+                num.printNumber();
+            }
+        }
+
+        size_t s = symbols.size();
+        symbols.resize(s + popcount64(symbolCells));
+
+        for (; symbolCells; symbolCells &= symbolCells - 1, ++s) {
+
+            int pos = base + countTrailingZeros64(symbolCells);
+
+            Symbol& symb = symbols[s];
+            symb.type = line[pos];
+            symb.row = ind;
+            symb.col = pos;
+
+            if (detail) {
+                std::cout << "Line: " << ind << ", ";
+                symb.printSymbol();
+            }
+        }
+    }
+}
+
+void GearRatios::parseFullSchematic(bool detail) {
+
+    for (int i = 0; i < schematic.rows; ++i) {
+        parseSchematicLine(i, detail);
+    }
+
+    //if (detail)
+
+    std::cout << "Total numbers parsed: " << numbers.size() << std::endl;
+    std::cout << "Total symbols parsed: " << symbols.size() << std::endl;
+
+    graph.build(numbers, symbols);
+}
+
+bool GearRatios::isPartNumber(int n, bool detail) const {
+
+    Number num = numbers[n];
+    if (detail) num.printNumber();
+
+    int c0 = num.colStart - 1;
+    int c1 = num.colEnd + 1;
+
+    // the border makes rows -1 / rows and columns -1 / cols readable
+    for (int r = num.row - 1; r <= num.row + 1; ++r) {
+
+        const char* line = schematic.row(r);
+        AOC_COUNT(Day3RowProbes, 1);
+
+        for (int c = c0; c <= c1; ++c) {
+            char ch = line[c];
+            if (ch != '.' && !std::isdigit((unsigned char)ch)) {
+                if (detail) std::cout << "Symbol " << ch << " touces number " << num.value << "\n";
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+int GearRatios::getSolutionPart1() const {
+
+    return (int)graph.partNumberSum();
+}
+
+int GearRatios::isTouchingTwoNumbers(int n, bool detail) const {
+
+    Symbol s = symbols[n];
+    if (detail) s.printSymbol();
+
+    int ratio = 1;
+    int count = 0;
+
+    for (int r = s.row - 1; r <= s.row + 1; ++r) {
+
+        const char* line = schematic.row(r);
+        AOC_COUNT(Day3RowProbes, 1);
+
+        for (int c = s.col - 1; c <= s.col + 1; ++c) {
+
+            // one number per digit run: count it at its first cell in the window
+            if (!std::isdigit((unsigned char)line[c])) continue;
+            if (c > s.col - 1 && std::isdigit((unsigned char)line[c - 1])) continue;
+
+            int start = c;
+            while (std::isdigit((unsigned char)line[start - 1])) start--;
+
+            int value = 0;
+            for (int p = start; std::isdigit((unsigned char)line[p]); ++p)
+                value = value * 10 + (line[p] - '0');
+
+            if (detail)
+                std::cout << "Number " << value << " touches * symbls\n";
+
+            count++;
+            ratio *= value;
+        }
+    }
+    if (count == 2) {
+        if (detail)
+            std::cout << "Found valid gear at ("
+                      << s.row << ", " << s.col << ")\n";
+        return ratio;
+    }
+
+    return -1;
+}
+
+int GearRatios::getSolutionPart2() const {
+
+    return (int)graph.productSum('*', 2);
+}
+
+
+
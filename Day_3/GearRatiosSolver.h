@@ -0,0 +1,34 @@
+#ifndef GEAR_RATIOS_SOLVER_H
+#define GEAR_RATIOS_SOLVER_H
+
+#include "Solver.h"
+#include "GearRatios.h"
+
+
+/**
+ * @class GearRatiosSolver
+ * @brief Day 3 on the Solver interface.
+ *
+ * The model is a GearRatios with the schematic read and all numbers
+ * and symbols extracted.
+ */
+
+class GearRatiosSolver : public Solver<GearRatiosSolver> {
+public:
+
+    typedef GearRatios Model;
+    static constexpr int day = 3;
+
+    Model parseInput(const std::string& path) const {
+        Model model(path);
+        if (!model.readMapped()) readInput(path, model);
+        model.parseFullSchematic(false);
+        return model;
+    }
+
+    int solvePart1(const Model& model) const { return model.getSolutionPart1(); }
+    int solvePart2(const Model& model) const { return model.getSolutionPart2(); }
+};
+
+
+#endif // GEAR_RATIOS_SOLVER_H
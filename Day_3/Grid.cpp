@@ -0,0 +1,89 @@
+#include "Grid.h"
+#include "InputSource.h"
+
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+void Grid::clear() {
+
+    rows = 0;
+    cols = 0;
+    stride = 2;
+    cells.assign(2 * stride + padding, border);
+}
+
+void Grid::appendRow(const char* data, size_t len) {
+
+    // widen: copy every row into the new stride
+    if ((int)len > cols) {
+
+        int newStride = (int)len + 2;
+        std::vector<char> wider((size_t)(rows + 2) * newStride + padding, border);
+
+        for (int r = 0; r < rows; ++r)
+            std::memcpy(wider.data() + (size_t)(r + 1) * newStride + 1, row(r), cols);
+
+        cells.swap(wider);
+        cols = (int)len;
+        stride = newStride;
+    }
+
+    // the new bottom border row; the old padding is all border cells
+    cells.resize((size_t)(rows + 3) * stride + padding, border);
+    std::memcpy(row(rows), data, len);
+    rows++;
+}
+
+bool Grid::loadMapped(const std::string& path) {
+
+    if (detectEncoding(path) != InputEncoding::Plain) return false;
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+
+    size_t size = (size_t)info.st_size;
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+
+    if (mapped == MAP_FAILED) return false;
+    madvise(mapped, size, MADV_SEQUENTIAL);
+
+    const char* data = static_cast<const char*>(mapped);
+    const char* firstNewline = static_cast<const char*>(std::memchr(data, '\n', size));
+
+    // width of the first row; every row must end exactly one stride later
+    size_t width = firstNewline ? (size_t)(firstNewline - data) : size;
+    size_t lineLength = width + 1;
+    size_t count = (size + 1) / lineLength;
+    bool uniform = width > 0 && count * lineLength >= size && count * lineLength <= size + 1;
+
+    for (size_t r = 0; uniform && r < count; ++r) {
+        const char* line = data + r * lineLength;
+        bool last = (r + 1 == count);
+        if (std::memchr(line, '\n', width) != nullptr) uniform = false;
+        else if (!(last && r * lineLength + width == size) && line[width] != '\n') uniform = false;
+    }
+
+    if (uniform) {
+
+        rows = (int)count;
+        cols = (int)width;
+        stride = cols + 2;
+        cells.assign((size_t)(rows + 2) * stride + padding, border);
+
+        for (int r = 0; r < rows; ++r)
+            std::memcpy(row(r), data + (size_t)r * lineLength, width);
+    }
+
+    munmap(mapped, size);
+    return uniform;
+}
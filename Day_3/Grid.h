@@ -0,0 +1,94 @@
+#ifndef GRID_H
+#define GRID_H
+
+#include <string>
+#include <vector>
+
+
+/**
+ * @class Grid
+ * @brief Character grid in one contiguous buffer with a sentinel border.
+ *
+ * Rows are stored back to back with a fixed stride of cols + 2: every
+ * row has one border cell on each side, and there is one border row
+ * above the first and below the last row. All border cells hold '.',
+ * so neighbor access for any cell, including row -1 / rows and column
+ * -1 / cols, needs no bounds checks and walks memory linearly.
+ *
+ * Rows shorter than the widest row are padded with '.', and the buffer
+ * ends with 64 more '.' cells, so a 64-byte load starting at any real
+ * cell stays inside it.
+ */
+
+class Grid {
+public:
+
+
+    // ================================================================
+    //                     CLASS MEMEBERS
+    // ================================================================
+
+    /** @brief The value of every border and padding cell. */
+    static constexpr char border = '.';
+
+    /** @brief Extra cells after the bottom border row. */
+    static constexpr int padding = 64;
+
+    /** @brief Number of rows, without the border. */
+    int rows = 0;
+
+    /** @brief Number of columns, without the border. */
+    int cols = 0;
+
+    /** @brief Distance between two rows in cells (cols + 2). */
+    int stride = 2;
+
+    /** @brief (rows + 2) * stride + padding cells, borders included. */
+    std::vector<char> cells;
+
+
+    // ================================================================
+    //                     ACCESS
+    // ================================================================
+
+    Grid() { cells.assign(2 * stride + padding, border); }
+
+    /** @brief Pointer to column 0 of row r; valid for r in [-1, rows]. */
+    char* row(int r) { return cells.data() + (size_t)(r + 1) * stride + 1; }
+    const char* row(int r) const { return cells.data() + (size_t)(r + 1) * stride + 1; }
+
+    /** @brief Cell (r, c); valid for r in [-1, rows] and c in [-1, cols]. */
+    char at(int r, int c) const { return row(r)[c]; }
+
+    /** @brief Removes all rows. */
+    void clear();
+
+
+    // ================================================================
+    //                     LOADING
+    // ================================================================
+
+    /**
+     * @brief Appends a row.
+     *
+     * A row wider than the grid widens every row (one copy of the
+     * buffer); shorter rows are padded.
+     */
+    void appendRow(const char* data, size_t len);
+    void appendRow(const std::string& line) { appendRow(line.data(), line.size()); }
+
+    /**
+     * @brief Loads a plain-text file whose rows all have the same width.
+     *
+     * The file is mapped and copied row by row into a buffer allocated
+     * once. Compressed files, empty files and files with rows of
+     * different widths are left alone, so the caller can fall back to
+     * appendRow().
+     *
+     * @return True if the grid was loaded.
+     */
+    bool loadMapped(const std::string& path);
+};
+
+
+#endif // GRID_H
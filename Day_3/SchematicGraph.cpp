@@ -0,0 +1,204 @@
+#include "SchematicGraph.h"
+#include "GearRatios.h"
+#include "Instrumentation.h"
+
+#include <algorithm>
+
+void SchematicGraph::build(const std::vector<Number>& numbers, const std::vector<Symbol>& symbols) {
+
+    int rows = 0;
+    for (const Number& num : numbers) rows = std::max(rows, num.row + 1);
+    for (const Symbol& s : symbols) rows = std::max(rows, s.row + 1);
+
+    // numbers bucketed by row (counting sort, column order kept)
+    std::vector<uint32_t> rowOffsets(rows + 1, 0);
+    for (const Number& num : numbers) rowOffsets[num.row + 1]++;
+    for (int r = 0; r < rows; ++r) rowOffsets[r + 1] += rowOffsets[r];
+
+    std::vector<uint32_t> rowNumbers(numbers.size());
+    {
+        std::vector<uint32_t> fill(rowOffsets.begin(), rowOffsets.end() - 1);
+        for (uint32_t n = 0; n < numbers.size(); ++n)
+            rowNumbers[fill[numbers[n].row]++] = n;
+    }
+
+    values.resize(numbers.size());
+    for (size_t n = 0; n < numbers.size(); ++n) values[n] = numbers[n].value;
+
+    types.resize(symbols.size());
+    for (size_t s = 0; s < symbols.size(); ++s) types[s] = symbols[s].type;
+
+    // symbol -> numbers, written in symbol order
+    symbolOffsets.assign(symbols.size() + 1, 0);
+    symbolNumbers.clear();
+
+    for (size_t s = 0; s < symbols.size(); ++s) {
+
+        const Symbol& sym = symbols[s];
+
+        for (int r = std::max(0, sym.row - 1); r <= std::min(rows - 1, sym.row + 1); ++r) {
+
+            const uint32_t* first = rowNumbers.data() + rowOffsets[r];
+            const uint32_t* last = rowNumbers.data() + rowOffsets[r + 1];
+
+            // first number of the row ending at or after col - 1
+            const uint32_t* it = std::partition_point(first, last,
+                [&](uint32_t n) { return numbers[n].colEnd < sym.col - 1; });
+
+            for (; it != last && numbers[*it].colStart <= sym.col + 1; ++it)
+                symbolNumbers.push_back(*it);
+
+            AOC_COUNT(Day3RowProbes, 1);
+        }
+
+        symbolOffsets[s + 1] = (uint32_t)symbolNumbers.size();
+    }
+
+    // number -> symbols: the transpose
+    numberOffsets.assign(numbers.size() + 1, 0);
+    for (uint32_t n : symbolNumbers) numberOffsets[n + 1]++;
+    for (size_t n = 0; n < numbers.size(); ++n) numberOffsets[n + 1] += numberOffsets[n];
+
+    numberSymbols.resize(symbolNumbers.size());
+    {
+        std::vector<uint32_t> fill(numberOffsets.begin(), numberOffsets.end() - 1);
+        for (uint32_t s = 0; s < symbols.size(); ++s)
+            for (uint32_t e = symbolOffsets[s]; e < symbolOffsets[s + 1]; ++e)
+                numberSymbols[fill[symbolNumbers[e]]++] = s;
+    }
+
+    // symbols bucketed by type and by degree
+    typeOffsets.assign(257, 0);
+    for (char t : types) typeOffsets[(unsigned char)t + 1]++;
+    for (int t = 0; t < 256; ++t) typeOffsets[t + 1] += typeOffsets[t];
+
+    symbolsByType.resize(symbols.size());
+    {
+        std::vector<uint32_t> fill(typeOffsets.begin(), typeOffsets.end() - 1);
+        for (uint32_t s = 0; s < symbols.size(); ++s)
+            symbolsByType[fill[(unsigned char)types[s]]++] = s;
+    }
+
+    maxDegree = 0;
+    for (size_t s = 0; s < symbols.size(); ++s) maxDegree = std::max(maxDegree, symbolDegree((int)s));
+
+    degreeOffsets.assign(maxDegree + 2, 0);
+    for (size_t s = 0; s < symbols.size(); ++s) degreeOffsets[symbolDegree((int)s) + 1]++;
+    for (int k = 0; k <= maxDegree; ++k) degreeOffsets[k + 1] += degreeOffsets[k];
+
+    symbolsByDegree.resize(symbols.size());
+    {
+        std::vector<uint32_t> fill(degreeOffsets.begin(), degreeOffsets.end() - 1);
+        for (uint32_t s = 0; s < symbols.size(); ++s)
+            symbolsByDegree[fill[symbolDegree((int)s)]++] = s;
+    }
+
+    size_t buckets = 256 * (size_t)(maxDegree + 1);
+    auto bucketOf = [&](uint32_t s) { return (size_t)(unsigned char)types[s] * (maxDegree + 1) + symbolDegree((int)s); };
+
+    typeDegreeOffsets.assign(buckets + 1, 0);
+    for (uint32_t s = 0; s < symbols.size(); ++s) typeDegreeOffsets[bucketOf(s) + 1]++;
+    for (size_t b = 0; b < buckets; ++b) typeDegreeOffsets[b + 1] += typeDegreeOffsets[b];
+
+    symbolsByTypeDegree.resize(symbols.size());
+    {
+        std::vector<uint32_t> fill(typeDegreeOffsets.begin(), typeDegreeOffsets.end() - 1);
+        for (uint32_t s = 0; s < symbols.size(); ++s)
+            symbolsByTypeDegree[fill[bucketOf(s)]++] = s;
+    }
+}
+
+std::vector<int> SchematicGraph::numbersAround(int s) const {
+
+    return std::vector<int>(symbolNumbers.begin() + symbolOffsets[s],
+                            symbolNumbers.begin() + symbolOffsets[s + 1]);
+}
+
+std::vector<int> SchematicGraph::symbolsOfType(char type) const {
+
+    unsigned char t = (unsigned char)type;
+    return std::vector<int>(symbolsByType.begin() + typeOffsets[t],
+                            symbolsByType.begin() + typeOffsets[t + 1]);
+}
+
+std::vector<int> SchematicGraph::numbersAdjacentTo(char type) const {
+
+    unsigned char t = (unsigned char)type;
+    std::vector<int> result;
+
+    // number n was already reported in this query if visited[n] == epoch;
+    // per thread and shared by every graph, so the graph stays read-only
+    thread_local std::vector<uint32_t> visited;
+    thread_local uint32_t epoch = 0;
+
+    if (visited.size() < values.size())
+        visited.resize(values.size(), 0);
+
+    // a fresh epoch forgets every earlier query in O(1)
+    if (++epoch == 0) {
+        std::fill(visited.begin(), visited.end(), 0);
+        epoch = 1;
+    }
+
+    // a number may touch several symbols of the type
+    for (uint32_t i = typeOffsets[t]; i < typeOffsets[t + 1]; ++i) {
+        uint32_t s = symbolsByType[i];
+        for (uint32_t e = symbolOffsets[s]; e < symbolOffsets[s + 1]; ++e) {
+            uint32_t n = symbolNumbers[e];
+            if (visited[n] != epoch) {
+                visited[n] = epoch;
+                result.push_back((int)n);
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<int> SchematicGraph::symbolsWithDegree(int k, char type) const {
+
+    std::vector<int> result;
+    if (k < 0 || k > maxDegree) return result;
+
+    if (type == 0)
+        return std::vector<int>(symbolsByDegree.begin() + degreeOffsets[k],
+                                symbolsByDegree.begin() + degreeOffsets[k + 1]);
+
+    size_t b = (size_t)(unsigned char)type * (maxDegree + 1) + k;
+    return std::vector<int>(symbolsByTypeDegree.begin() + typeDegreeOffsets[b],
+                            symbolsByTypeDegree.begin() + typeDegreeOffsets[b + 1]);
+}
+
+long long SchematicGraph::symbolSum(int s) const {
+
+    long long sum = 0;
+    for (uint32_t e = symbolOffsets[s]; e < symbolOffsets[s + 1]; ++e)
+        sum += values[symbolNumbers[e]];
+    return sum;
+}
+
+long long SchematicGraph::symbolProduct(int s) const {
+
+    long long product = 1;
+    for (uint32_t e = symbolOffsets[s]; e < symbolOffsets[s + 1]; ++e)
+        product *= values[symbolNumbers[e]];
+    return product;
+}
+
+long long SchematicGraph::partNumberSum() const {
+
+    long long sum = 0;
+    for (size_t n = 0; n < values.size(); ++n)
+        if (numberOffsets[n + 1] > numberOffsets[n]) sum += values[n];
+    return sum;
+}
+
+long long SchematicGraph::productSum(char type, int k) const {
+
+    long long sum = 0;
+    if (k < 0 || k > maxDegree) return sum;
+
+    size_t b = (size_t)(unsigned char)type * (maxDegree + 1) + k;
+    for (uint32_t i = typeDegreeOffsets[b]; i < typeDegreeOffsets[b + 1]; ++i)
+        sum += symbolProduct((int)symbolsByTypeDegree[i]);
+    return sum;
+}
@@ -0,0 +1,136 @@
+#ifndef SCHEMATIC_GRAPH_H
+#define SCHEMATIC_GRAPH_H
+
+#include <cstdint>
+#include <vector>
+
+struct Number;
+struct Symbol;
+
+
+/**
+ * @class SchematicGraph
+ * @brief Bipartite adjacency between symbols and numbers, stored as CSR.
+ *
+ * Built once from the parsed numbers and symbols; afterwards every
+ * query costs time linear in its answer instead of a scan of the whole
+ * schematic:
+ *   - numbers adjacent to a symbol, or to any symbol of a type
+ *   - symbols touching exactly k numbers (optionally of one type)
+ *   - sums and products of the numbers around a symbol
+ *
+ * Compressed sparse row layout: the neighbors of symbol s are
+ * symbolNumbers[symbolOffsets[s] .. symbolOffsets[s + 1]), and the
+ * transposed arrays hold the symbols around every number. Symbols are
+ * additionally bucketed by type, by degree and by (type, degree).
+ */
+
+class SchematicGraph {
+public:
+
+
+    // ================================================================
+    //                     CLASS MEMEBERS
+    // ================================================================
+
+    /** @brief Symbol s touches symbolNumbers[symbolOffsets[s] .. symbolOffsets[s + 1]). */
+    std::vector<uint32_t> symbolOffsets;
+    std::vector<uint32_t> symbolNumbers;
+
+    /** @brief Number n touches numberSymbols[numberOffsets[n] .. numberOffsets[n + 1]). */
+    std::vector<uint32_t> numberOffsets;
+    std::vector<uint32_t> numberSymbols;
+
+    /** @brief Symbols of type t are symbolsByType[typeOffsets[t] .. typeOffsets[t + 1]). */
+    std::vector<uint32_t> typeOffsets;
+    std::vector<uint32_t> symbolsByType;
+
+    /** @brief Symbols touching k numbers are symbolsByDegree[degreeOffsets[k] .. degreeOffsets[k + 1]). */
+    std::vector<uint32_t> degreeOffsets;
+    std::vector<uint32_t> symbolsByDegree;
+
+    /**
+     * @brief Symbols of type t touching k numbers, bucket b = t * (maxDegree + 1) + k:
+     * symbolsByTypeDegree[typeDegreeOffsets[b] .. typeDegreeOffsets[b + 1]).
+     */
+    std::vector<uint32_t> typeDegreeOffsets;
+    std::vector<uint32_t> symbolsByTypeDegree;
+
+    /** @brief Largest number of numbers touching one symbol. */
+    int maxDegree = 0;
+
+    /** @brief Values of the numbers, copied so that queries need no schematic. */
+    std::vector<int> values;
+
+    /** @brief Symbol types, copied for the same reason. */
+    std::vector<char> types;
+
+
+    // ================================================================
+    //                     CONSTRUCTION
+    // ================================================================
+
+    /**
+     * @brief Builds the graph.
+     *
+     * The numbers of each row must be in column order, as produced by
+     * GearRatios::parseSchematicLine(). Each symbol looks up the numbers
+     * of its three rows by binary search, so the build costs
+     * O((numbers + symbols) log(numbers per row)).
+     */
+    void build(const std::vector<Number>& numbers, const std::vector<Symbol>& symbols);
+
+
+    // ================================================================
+    //                     QUERIES
+    // ================================================================
+
+    /** @brief Number of numbers touching symbol s. */
+    int symbolDegree(int s) const { return (int)(symbolOffsets[s + 1] - symbolOffsets[s]); }
+
+    /** @brief Number of symbols touching number n. */
+    int numberDegree(int n) const { return (int)(numberOffsets[n + 1] - numberOffsets[n]); }
+
+    /** @brief Indices of the numbers touching symbol s. */
+    std::vector<int> numbersAround(int s) const;
+
+    /** @brief Indices of all symbols of the given type. */
+    std::vector<int> symbolsOfType(char type) const;
+
+    /**
+     * @brief Distinct numbers touching at least one symbol of the type,
+     * in order of first appearance.
+     *
+     * Duplicates are dropped with a per-thread epoch array, so the cost
+     * is linear in the adjacency of the type's symbols; no sort. The
+     * graph itself is not written, so threads may query it concurrently.
+     */
+    std::vector<int> numbersAdjacentTo(char type) const;
+
+    /**
+     * @brief Symbols touching exactly k numbers.
+     *
+     * Reads one bucket, so the cost is linear in the answer.
+     *
+     * @param type Restrict to one symbol type; 0 for any type.
+     */
+    std::vector<int> symbolsWithDegree(int k, char type = 0) const;
+
+    /** @brief Sum of the numbers touching symbol s. */
+    long long symbolSum(int s) const;
+
+    /** @brief Product of the numbers touching symbol s (1 if none). */
+    long long symbolProduct(int s) const;
+
+    /** @brief Sum of the numbers that touch at least one symbol (Part 1). */
+    long long partNumberSum() const;
+
+    /**
+     * @brief Sum of symbolProduct() over the symbols of a type that
+     * touch exactly k numbers ('*' and 2 give Part 2).
+     */
+    long long productSum(char type, int k) const;
+};
+
+
+#endif // SCHEMATIC_GRAPH_H
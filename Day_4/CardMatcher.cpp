@@ -0,0 +1,193 @@
+#include "CardMatcher.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+
+// ================================================================
+//                     SIMD BLOCKS
+// ================================================================
+//
+// One block of each side is compared all-pairs: the block of winning
+// numbers is rotated through every lane and compared for equality.
+//   - AVX2: 8 x 8 ints, 8 compares
+//   - SSE2: 4 x 4 ints, 4 compares
+//
+// Without either, Simd falls back to the merge.
+
+#if defined(__AVX2__)
+
+#define CARD_SIMD_LANES 8
+
+static inline int matchBlock(const int* a, const int* b) {
+
+    __m256i va = _mm256_loadu_si256((const __m256i*)a);
+    __m256i vb = _mm256_loadu_si256((const __m256i*)b);
+    __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+    __m256i eq = _mm256_cmpeq_epi32(va, vb);
+
+    for (int r = 1; r < 8; ++r) {
+        vb = _mm256_permutevar8x32_epi32(vb, rotate);
+        eq = _mm256_or_si256(eq, _mm256_cmpeq_epi32(va, vb));
+    }
+
+    return __builtin_popcount((unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(eq)));
+}
+
+#elif defined(__SSE2__)
+
+#define CARD_SIMD_LANES 4
+
+static inline int matchBlock(const int* a, const int* b) {
+
+    __m128i va = _mm_loadu_si128((const __m128i*)a);
+    __m128i vb = _mm_loadu_si128((const __m128i*)b);
+    __m128i eq = _mm_cmpeq_epi32(va, vb);
+    eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x39)));
+    eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x4E)));
+    eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x93)));
+
+    return __builtin_popcount((unsigned)_mm_movemask_ps(_mm_castsi128_ps(eq)));
+}
+
+#else
+
+#define CARD_SIMD_LANES 1
+
+#endif
+
+
+// ================================================================
+//                     KERNELS
+// ================================================================
+
+static int matchMerge(const int* a, size_t na, const int* b, size_t nb) {
+
+    int count = 0;
+    size_t i = 0, j = 0;
+
+    // j stays on a match, so repeated numbers all count
+    while (i < na && j < nb) {
+        if (a[i] < b[j]) i++;
+        else if (a[i] > b[j]) j++;
+        else { count++; i++; }
+    }
+    return count;
+}
+
+static int matchSimd(const int* a, size_t na, const int* b, size_t nb) {
+
+    int count = 0;
+    size_t i = 0, j = 0;
+
+#if CARD_SIMD_LANES > 1
+    const size_t L = CARD_SIMD_LANES;
+
+    // each number matches at most one (distinct) winning number, so a
+    // block pair never counts twice; a block of numbers moves on once
+    // every later winning number is larger than all of it
+    while (i + L <= na && j + L <= nb) {
+        count += matchBlock(a + i, b + j);
+        if (a[i + L - 1] <= b[j + L - 1]) i += L;
+        else j += L;
+    }
+#endif
+
+    return count + matchMerge(a + i, na - i, b + j, nb - j);
+}
+
+static int matchGalloping(const int* a, size_t na, const int* b, size_t nb) {
+
+    int count = 0;
+
+    if (na <= nb) {
+
+        // each number: exponential then binary search among the winning numbers
+        const int* lo = b;
+        const int* end = b + nb;
+
+        for (size_t i = 0; i < na && lo < end; ++i) {
+            size_t step = 1;
+            while (step < (size_t)(end - lo) && lo[step] < a[i]) step *= 2;
+            lo = std::lower_bound(lo, lo + std::min(step + 1, (size_t)(end - lo)), a[i]);
+            if (lo < end && *lo == a[i]) count++;
+        }
+    }
+    else {
+
+        // each winning number: its run among the numbers
+        const int* lo = a;
+        const int* end = a + na;
+
+        for (size_t j = 0; j < nb && lo < end; ++j) {
+            size_t step = 1;
+            while (step < (size_t)(end - lo) && lo[step] < b[j]) step *= 2;
+            lo = std::lower_bound(lo, lo + std::min(step + 1, (size_t)(end - lo)), b[j]);
+            while (lo < end && *lo == b[j]) { count++; lo++; }
+        }
+    }
+
+    return count;
+}
+
+static int matchBitmask(const int* a, size_t na, const int* b, size_t nb) {
+
+    uint64_t bits[bitmaskRange / 64] = {};
+    long long base = b[0];
+    long long top = b[nb - 1];
+
+    for (size_t j = 0; j < nb; ++j) {
+        long long offset = b[j] - base;
+        bits[offset >> 6] |= 1ULL << (offset & 63);
+    }
+
+    int count = 0;
+    for (size_t i = 0; i < na; ++i) {
+        long long offset = (long long)a[i] - base;
+        if (a[i] >= base && a[i] <= top && (bits[offset >> 6] >> (offset & 63) & 1)) count++;
+    }
+    return count;
+}
+
+
+CardMatcher chooseCardMatcher(const std::vector<int>& numbers, const std::vector<int>& winning) {
+
+    if (!winning.empty() && (long long)winning.back() - winning.front() < bitmaskRange)
+        return CardMatcher::Bitmask;
+
+    size_t shorter = std::min(numbers.size(), winning.size());
+    size_t longer = std::max(numbers.size(), winning.size());
+
+    if (shorter * gallopRatio <= longer) return CardMatcher::Galloping;
+    if (CARD_SIMD_LANES > 1 && shorter >= CARD_SIMD_LANES) return CardMatcher::Simd;
+    return CardMatcher::Merge;
+}
+
+int countCardMatches(const std::vector<int>& numbers, const std::vector<int>& winning) {
+
+    return countCardMatches(numbers, winning, chooseCardMatcher(numbers, winning));
+}
+
+int countCardMatches(const std::vector<int>& numbers, const std::vector<int>& winning, CardMatcher matcher) {
+
+    if (numbers.empty() || winning.empty()) return 0;
+
+    const int* a = numbers.data();
+    const int* b = winning.data();
+
+    switch (matcher) {
+        case CardMatcher::Bitmask:
+            if ((long long)winning.back() - winning.front() < bitmaskRange)
+                return matchBitmask(a, numbers.size(), b, winning.size());
+            break;
+        case CardMatcher::Simd: return matchSimd(a, numbers.size(), b, winning.size());
+        case CardMatcher::Galloping: return matchGalloping(a, numbers.size(), b, winning.size());
+        case CardMatcher::Merge: break;
+    }
+
+    return matchMerge(a, numbers.size(), b, winning.size());
+}
@@ -0,0 +1,53 @@
+#ifndef CARD_MATCHER_H
+#define CARD_MATCHER_H
+
+#include <cstddef>
+#include <vector>
+
+
+// ================================================================
+//                     CARD MATCHERS
+// ================================================================
+//
+// All matchers count the elements of 'numbers' (with repeats) that
+// occur in 'winning'. Both vectors must be sorted ascending, and
+// 'winning' must hold no repeats; Scratchcard::parseCard() does both.
+
+/**
+ * @enum CardMatcher
+ * @brief The kernels chooseCardMatcher() picks from.
+ */
+
+enum class CardMatcher {
+    Bitmask,    ///< winning numbers as bits; needs a narrow winning range
+    Simd,       ///< block-wise all-pairs compare of two sorted arrays
+    Galloping,  ///< exponential search of the short side in the long one
+    Merge       ///< plain sorted merge, for short tails
+};
+
+/**
+ * @brief Picks the matcher for one card in O(1).
+ *
+ * Uses the range of the winning numbers (front to back) and the sizes
+ * of both sides:
+ *   - winning range below bitmaskRange: Bitmask
+ *   - one side gallopRatio times longer than the other: Galloping
+ *   - both sides at least one SIMD block long: Simd
+ *   - otherwise: Merge
+ */
+CardMatcher chooseCardMatcher(const std::vector<int>& numbers, const std::vector<int>& winning);
+
+/** @brief Counts matches with the matcher chooseCardMatcher() picks. */
+int countCardMatches(const std::vector<int>& numbers, const std::vector<int>& winning);
+
+/** @brief Counts matches with the given matcher. */
+int countCardMatches(const std::vector<int>& numbers, const std::vector<int>& winning, CardMatcher matcher);
+
+/** @brief Largest winning range (back - front) handled by the bitmask matcher. */
+constexpr long long bitmaskRange = 1024;
+
+/** @brief Size ratio from which galloping beats a merge. */
+constexpr size_t gallopRatio = 32;
+
+
+#endif // CARD_MATCHER_H
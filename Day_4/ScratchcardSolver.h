@@ -0,0 +1,30 @@
+#ifndef SCRATCHCARD_SOLVER_H
+#define SCRATCHCARD_SOLVER_H
+
+#include "Solver.h"
+#include "Scratchcard.h"
+
+
+/**
+ * @class ScratchcardSolver
+ * @brief Day 4 on the Solver interface; the model is a parsed Scratchcard.
+ */
+
+class ScratchcardSolver : public Solver<ScratchcardSolver> {
+public:
+
+    typedef Scratchcard Model;
+    static constexpr int day = 4;
+
+    Model parseInput(const std::string& path) const {
+        Model model(path);
+        readInput(path, model);
+        return model;
+    }
+
+    int solvePart1(const Model& model) const { return model.getSolutionPart1(); }
+    long long solvePart2(const Model& model) const { return model.getSolutionPart2(); }
+};
+
+
+#endif // SCRATCHCARD_SOLVER_H
@@ -0,0 +1,63 @@
+#include "ScratchcardStream.h"
+
+#include <stdexcept>
+#include <iostream>
+
+ScratchcardStream::ScratchcardStream(const std::string& input)
+    : puzzleInput(input)
+{}
+
+void ScratchcardStream::readPuzzleInput() {
+
+    // plain, gzip or zstd; lines arrive through consumeLine()
+    if (!readChunked(puzzleInput, *this))
+        throw std::runtime_error("cannot read " + puzzleInput);
+}
+
+void ScratchcardStream::consumeLine(const std::string& line) {
+
+    Scratchcard::parseCard(line, card);
+    addCard(Scratchcard::countMatches(card));
+
+    if (reportEvery > 0 && cardCount % reportEvery == 0)
+        std::cout << cardCount << " cards: Part 1 = " << part1 << ", Part 2 = " << part2 << std::endl;
+}
+
+void ScratchcardStream::finishInput() {
+
+    std::cout << "Streamed " << cardCount << " cards (window " << pending.size() << ")" << std::endl;
+}
+
+void ScratchcardStream::addCard(int matches) {
+
+    reserveWindow((size_t)matches);
+
+    // this card: the original plus everything earlier cards sent ahead
+    long long copies = 1;
+    if (!pending.empty()) {
+        copies += pending[head];
+        pending[head] = 0;
+        head = (head + 1) % pending.size();
+    }
+
+    cardCount++;
+    part2 += copies;
+    if (matches > 0) part1 += 1LL << (matches - 1);
+
+    // the next k cards, starting at the new head
+    for (int j = 0; j < matches; ++j)
+        pending[(head + j) % pending.size()] += copies;
+}
+
+void ScratchcardStream::reserveWindow(size_t k) {
+
+    if (k <= pending.size()) return;
+
+    // unroll the ring so that the next card's slot is first
+    std::vector<long long> wider(k, 0);
+    for (size_t j = 0; j < pending.size(); ++j)
+        wider[j] = pending[(head + j) % pending.size()];
+
+    pending.swap(wider);
+    head = 0;
+}
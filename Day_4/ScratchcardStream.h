@@ -0,0 +1,97 @@
+#ifndef SCRATCHCARD_STREAM_H
+#define SCRATCHCARD_STREAM_H
+
+#include <string>
+#include <vector>
+
+#include "ChunkedReader.h"
+#include "Scratchcard.h"
+
+
+/**
+ * @class ScratchcardStream
+ * @brief Solves Day 4 one card at a time, in memory bounded by the
+ * largest match count.
+ *
+ * Card i only adds copies to cards i+1..i+k (k = its matches), so the
+ * only Part 2 state is a ring buffer of the copies still pending for
+ * the next cards. The ring grows to the largest k seen; cards, matches
+ * and copies are never stored, and Part 1 and Part 2 are running totals.
+ *
+ * Copies pending for cards after the last one are never counted, as in
+ * Scratchcard::getSolutionPart2().
+ */
+
+class ScratchcardStream : public LineConsumer {
+public:
+
+
+    // ================================================================
+    //                     CLASS MEMEBERS
+    // ================================================================
+
+    /** @brief Path to the puzzle input file. */
+    std::string puzzleInput;
+
+    /** @brief Print the running totals every this many cards (0 = never). */
+    long long reportEvery = 0;
+
+    /** @brief Cards read so far. */
+    long long cardCount = 0;
+
+    /** @brief Running Part 1 total (points). */
+    long long part1 = 0;
+
+    /** @brief Running Part 2 total (cards including copies). */
+    long long part2 = 0;
+
+    /**
+     * @brief Copies pending for the next cards: pending[(head + j) % size]
+     * belongs to the card j + 1 positions after the last one read.
+     */
+    std::vector<long long> pending;
+    size_t head = 0;
+
+    /** @brief Reused parse buffer. */
+    Card card;
+
+
+    // ================================================================
+    //                     STREAMING
+    // ================================================================
+
+    /**
+     * @brief Constructs the stream for the given input file.
+     * @param input Path to puzzle input.
+     */
+    ScratchcardStream(const std::string& input);
+
+    /**
+     * @brief Streams the input file through consumeLine().
+     *
+     * The file may be gzip or zstd compressed (see readChunked()).
+     *
+     * @throws std::runtime_error if the file cannot be read or decompressed.
+     */
+    void readPuzzleInput();
+
+    /** @brief Parses one card and folds it into the totals (LineConsumer). */
+    void consumeLine(const std::string& line) override;
+
+    /** @brief Reports the final totals. */
+    void finishInput() override;
+
+    /**
+     * @brief Folds a card with the given match count into the totals.
+     *
+     * Takes the card's pending copies out of the ring, then adds its
+     * copies to the next k slots, growing the ring first if k exceeds it.
+     */
+    void addCard(int matches);
+
+    /** @brief Grows the ring to at least k slots, keeping the pending order. */
+    void reserveWindow(size_t k);
+};
+
+
+#endif // SCRATCHCARD_STREAM_H
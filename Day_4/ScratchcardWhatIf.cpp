@@ -0,0 +1,141 @@
+#include "ScratchcardWhatIf.h"
+
+#include <algorithm>
+
+void FenwickTree::build(const std::vector<long long>& values) {
+
+    tree.assign(values.size() + 1, 0);
+
+    for (size_t i = 1; i <= values.size(); ++i) {
+        tree[i] += values[i - 1];
+        size_t parent = i + (i & (0 - i));
+        if (parent <= values.size()) tree[parent] += tree[i];
+    }
+}
+
+void FenwickTree::add(int i, long long delta) {
+
+    for (size_t k = (size_t)i + 1; k < tree.size(); k += k & (0 - k))
+        tree[k] += delta;
+}
+
+long long FenwickTree::prefix(int i) const {
+
+    long long sum = 0;
+    for (size_t k = (size_t)i; k > 0; k -= k & (0 - k))
+        sum += tree[k];
+    return sum;
+}
+
+
+ScratchcardWhatIf::ScratchcardWhatIf(const std::vector<int>& cardMatches)
+    : matches(cardMatches)
+{
+    int n = (int)matches.size();
+
+    copies.assign(n, 1);
+    Scratchcard::propagateCopies(matches, copies);
+
+    // backward: values[t] = 1 + values[t + 1] + ... + values[windowEnd], via suffix sums
+    values.assign(n, 1);
+    std::vector<long long> suffix(n + 1, 0);
+
+    for (int t = n - 1; t >= 0; --t) {
+        values[t] = 1 + suffix[t + 1] - suffix[windowEnd(t, matches[t]) + 1];
+        suffix[t] = suffix[t + 1] + values[t];
+    }
+
+    valueSums.build(values);
+
+    for (long long c : copies) total += c;
+    for (int k : matches) maxMatches = std::max(maxMatches, k);
+
+    scratch.assign(n + 2, 0);
+}
+
+ScratchcardWhatIf::ScratchcardWhatIf(const Scratchcard& cards)
+    : ScratchcardWhatIf([&] {
+          std::vector<int> m(cards.cards.size());
+          for (int i = 0; i < (int)m.size(); ++i) m[i] = cards.getMatches(i);
+          return m;
+      }())
+{}
+
+int ScratchcardWhatIf::windowEnd(int i, int k) const {
+
+    // copies past the last card do not exist
+    return std::min(i + k, (int)matches.size() - 1);
+}
+
+long long ScratchcardWhatIf::whatIf(int card, int newMatches) const {
+
+    int oldEnd = windowEnd(card, matches[card]);
+    int newEnd = windowEnd(card, newMatches);
+
+    long long gained = (newEnd > oldEnd) ? valueSums.rangeSum(oldEnd + 1, newEnd)
+                                         : -valueSums.rangeSum(newEnd + 1, oldEnd);
+
+    return total + copies[card] * gained;
+}
+
+void ScratchcardWhatIf::update(int card, int newMatches) {
+
+    int oldEnd = windowEnd(card, matches[card]);
+    int newEnd = windowEnd(card, newMatches);
+
+    total = whatIf(card, newMatches);
+    matches[card] = newMatches;
+    maxMatches = std::max(maxMatches, newMatches);
+
+    if (oldEnd == newEnd) return;
+
+    // forward: changes of copies after card, as a difference array in scratch
+    scratch[oldEnd + 1] += copies[card];
+    scratch[newEnd + 1] -= copies[card];
+
+    int reach = std::max(oldEnd, newEnd);
+    long long delta = 0;
+
+    for (int t = card + 1; t <= reach; ++t) {
+
+        delta += scratch[t];
+        scratch[t] = 0;
+        if (delta == 0) continue;
+
+        copies[t] += delta;
+
+        int end = windowEnd(t, matches[t]);
+        if (end > t) {
+            scratch[t + 1] += delta;
+            scratch[end + 1] -= delta;
+            reach = std::max(reach, end);
+        }
+    }
+    scratch[reach + 1] = 0;
+
+    // backward: changes of values before card; scratch holds their suffix sums
+    long long valueDelta = (newEnd > oldEnd) ? valueSums.rangeSum(oldEnd + 1, newEnd)
+                                             : -valueSums.rangeSum(newEnd + 1, oldEnd);
+
+    values[card] += valueDelta;
+    valueSums.add(card, valueDelta);
+    scratch[card] = valueDelta;
+
+    // cards before lowest - maxMatches cannot see a changed value
+    int lowest = card;
+    int j = card - 1;
+
+    for (; j >= 0 && j + maxMatches >= lowest; --j) {
+
+        long long d = scratch[j + 1] - scratch[windowEnd(j, matches[j]) + 1];
+        scratch[j] = scratch[j + 1] + d;
+
+        if (d != 0) {
+            values[j] += d;
+            valueSums.add(j, d);
+            lowest = j;
+        }
+    }
+
+    std::fill(scratch.begin() + (j + 1), scratch.begin() + (card + 1), 0);
+}
@@ -0,0 +1,128 @@
+#ifndef SCRATCHCARD_WHAT_IF_H
+#define SCRATCHCARD_WHAT_IF_H
+
+#include <vector>
+
+#include "Scratchcard.h"
+
+
+/**
+ * @struct FenwickTree
+ * @brief Prefix sums of a long long array under point updates, O(log n) each.
+ */
+
+struct FenwickTree {
+
+    std::vector<long long> tree;   // 1-based
+
+    /** @brief Builds the tree over values in O(n). */
+    void build(const std::vector<long long>& values);
+
+    /** @brief values[i] += delta. */
+    void add(int i, long long delta);
+
+    /** @brief values[0] + ... + values[i - 1]. */
+    long long prefix(int i) const;
+
+    /** @brief values[first] + ... + values[last]; 0 if first > last. */
+    long long rangeSum(int first, int last) const {
+        return first > last ? 0 : prefix(last + 1) - prefix(first);
+    }
+};
+
+
+/**
+ * @class ScratchcardWhatIf
+ * @brief Part 2 totals under changes to single cards' match counts.
+ *
+ * Two views of the same propagation are kept:
+ *   - copies[t]: copies of card t (forward pass, as processMatches())
+ *   - values[t]: cards produced by one copy of card t, itself included
+ *     (backward pass: 1 + values of the next matches[t] cards)
+ *
+ * The total is the sum of copies, and also the sum of values. Changing
+ * matches[i] changes card i's window by a range u of cards after i.
+ * Card i's copies do not depend on that window, so the new total is
+ *
+ *     total + copies[i] * (sum of values over u)
+ *
+ * (a rank-one update of the propagation matrix). With the values in a
+ * Fenwick tree, whatIf() costs O(log n).
+ *
+ * update() commits a change. The copies of the following cards are
+ * patched only as far as the change reaches. The values of the preceding
+ * cards are patched the same way, in reverse, with their Fenwick entries.
+ */
+
+class ScratchcardWhatIf {
+public:
+
+
+    // ================================================================
+    //                     CLASS MEMEBERS
+    // ================================================================
+
+    /** @brief matches[i] = number of matches for card i. */
+    std::vector<int> matches;
+
+    /** @brief Copies per card. */
+    std::vector<long long> copies;
+
+    /** @brief Cards produced by one copy of each card. */
+    std::vector<long long> values;
+
+    /** @brief Range sums over values. */
+    FenwickTree valueSums;
+
+    /** @brief Sum of all copies (Part 2). */
+    long long total = 0;
+
+    /** @brief Upper bound of all match counts, for the backward patch. */
+    int maxMatches = 0;
+
+    /** @brief Zeroed scratch for the patches, reset after each use. */
+    std::vector<long long> scratch;
+
+
+    // ================================================================
+    //                     CONSTRUCTION
+    // ================================================================
+
+    /** @brief Builds both passes for the given match counts. */
+    explicit ScratchcardWhatIf(const std::vector<int>& matches);
+
+    /** @brief Builds both passes for the cards of a parsed Scratchcard. */
+    explicit ScratchcardWhatIf(const Scratchcard& cards);
+
+
+    // ================================================================
+    //                     QUERIES AND UPDATES
+    // ================================================================
+
+    /**
+     * @brief Part 2 total if card's match count were newMatches.
+     *
+     * Nothing is modified; O(log n).
+     */
+    long long whatIf(int card, int newMatches) const;
+
+    /** @brief Part 2 total if card had the numbers of c. */
+    long long whatIf(int card, const Card& c) const { return whatIf(card, Scratchcard::countMatches(c)); }
+
+    /**
+     * @brief Sets card's match count to newMatches and patches copies,
+     * values and total.
+     *
+     * Costs O(span + changed values * log n), where span is the range of
+     * cards whose copies or values actually change.
+     */
+    void update(int card, int newMatches);
+
+private:
+
+    /** @brief Last card in the window of card i with k matches. */
+    int windowEnd(int i, int k) const;
+};
+
+
+#endif // SCRATCHCARD_WHAT_IF_H
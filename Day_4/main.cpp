@@ -1,22 +1,49 @@
-#include "Scratchcard.cpp"
-
-using namespace std;
-
-int main() {
-
-    std::cout << "--- Aoc 2023 Day 3 - Part 1 ---"  << std::endl;
-
-    Scratchcard game("input.txt");
-    game.readPuzzleInput();
-    int sol1 = game.getSolutionPart1();
-
-    std::cout << "Part 1 Solution: " << sol1 << std::endl;
-
-    std::cout << "\n--- Aoc 2023 Day 3 - Part 2 ---"  << std::endl;
-    long long sol2 = game.getSolutionPart2();
-
-    std::cout << "Part 2 Solution: " << sol2 << std::endl;
-
-
-    return 0;
-}
+#include "Scratchcard.h"
+#include "ScratchcardStream.h"
+
+#include <iostream>
+
+using namespace std;
+
+int main(int argc, char** argv) {
+
+    // day4 --stream [file]: constant memory, totals every 100000 cards
+    if (argc > 1 && std::string(argv[1]) == "--stream") {
+
+        ScratchcardStream stream(argc > 2 ? argv[2] : "input.txt");
+        stream.reportEvery = 100000;
+        try {
+            stream.readPuzzleInput();
+        }
+        catch (const std::exception& e) {
+            std::cerr << "error: " << e.what() << std::endl;
+            return 1;
+        }
+
+        std::cout << "Part 1 Solution: " << stream.part1 << std::endl;
+        std::cout << "Part 2 Solution: " << stream.part2 << std::endl;
+        return 0;
+    }
+
+    std::cout << "--- Aoc 2023 Day 3 - Part 1 ---"  << std::endl;
+
+    Scratchcard game("input.txt");
+    try {
+        game.readPuzzleInput();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "error: " << e.what() << std::endl;
+        return 1;
+    }
+    int sol1 = game.getSolutionPart1();
+
+    std::cout << "Part 1 Solution: " << sol1 << std::endl;
+
+    std::cout << "\n--- Aoc 2023 Day 3 - Part 2 ---"  << std::endl;
+    long long sol2 = game.getSolutionPart2();
+
+    std::cout << "Part 2 Solution: " << sol2 << std::endl;
+
+
+    return 0;
+}
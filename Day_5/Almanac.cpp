@@ -1,251 +1,1100 @@
-#include "Almanac.h"
-
-#include <iostream>
-#include <fstream>
-#include <sstream>
-#include <limits>
-
-
-void Rule::printRule() const {
-
-    std::cout << "[srcStart, srcEnd, range] = " << "[" << srcStart << ", " << srcEnd << ", " << delta << "]\n";
-    std::cout << "Source Interval: [" << srcStart << ", " << srcEnd << "]\n";
-    std::cout << "Dest Interval: [" << (srcStart + delta) << ", " << (srcEnd + delta) << "]\n";
-
-    // destStart = srcStart + delta
-    // destEnd = srcEnd + delta
-}
-
-long long RuleMap::apply(long long x) const {
-
-    for (const auto& r : rules) {
-        if (x >= r.srcStart && x <= r.srcEnd)
-            return x + r.delta;
-    }
-    return x;
-}
-
-void RuleMap::printRuleMap() const {
-    std::cout << "Rule '" << name << "' (" << rules.size() << " rules)\n";
-}
-
-
-
-Almanac::Almanac(const std::string& input)
-    : puzzleInput(input)
-{}
-
-void Almanac::readPuzzleInput() {
-
-    bool detail = false;
-
-    std::ifstream file(puzzleInput);
-    std::string line;
-
-    RuleMap current;     // temp map being built
-    bool inMap = false;  // true if in map section
-
-    // read puzzle input
-    while (std::getline(file, line)) {
-
-        // blank lines separate sections -> skip
-        if (line.empty()) continue;
-
-        // if line starts with "seeds:"
-        if (line.rfind("seeds:", 0) == 0) {
-
-            // extract numbers after colon
-            std::stringstream ss(line.substr(6));
-            long long x;
-            // push into seeds vector
-            while (ss >> x)
-                seeds.push_back(x);
-            continue;
-        }
-
-        // if line contains "map:"
-        if (line.find("map:") != std::string::npos) {
-
-            // if already in map section
-            if (inMap) {
-                ruleMaps.push_back(current);  // save it
-                current = RuleMap{};          // start a new map
-            }
-
-            inMap = true;
-            current.name = line;   // save name (optional)
-            continue;
-        }
-
-        // if we are in map section, in numeric line
-        if (inMap) {
-
-            // read values
-            std::stringstream ss(line);
-            long long destStart, srcStart, length;
-            ss >> destStart >> srcStart >> length;
-
-            // build the rule and convert: destStart sourceStart delta
-            // into:
-            //  - source interval
-            //  - delta offset
-
-            Rule r;
-            r.srcStart = srcStart;
-            r.srcEnd = srcStart + length - 1; // inclusive
-            r.delta = destStart - srcStart;
-
-            if (detail) r.printRule();
-
-            // save the rule
-            current.rules.push_back(r);
-        }
-    }
-
-    // after finishing line, we push back last map
-    // since there is no blank line after the final block
-    if (inMap) {
-        ruleMaps.push_back(current);
-        if (detail) current.printRuleMap();
-    }
-
-    if (detail) {
-        std::cout << "Total seeds read from file: " << seeds.size() << std::endl;
-        std::cout << "Total rule maps: " << ruleMaps.size() << std::endl;
-    }
-
-}
-
-long long Almanac::applySingleSeed(long long seed) {
-
-    long long value = seed;
-
-    for (const auto& map : ruleMaps)
-        value = map.apply(value);
-
-    return value;
-}
-
-long long Almanac::getSolutionPart1() {
-
-    long long minimumValue = std::numeric_limits<long long>::max();
-
-    for (long long s : seeds) {
-        long long location = applySingleSeed(s);
-        if (location < minimumValue)
-            minimumValue = location;
-    }
-
-    return minimumValue;
-}
-
-
-void Almanac::setSeedIntervals() {
-
-    for (int i = 0; i < (int)seeds.size(); i += 2) {
-        long long start = seeds[i];
-        long long length = seeds[i+1];
-
-        seedIntervals.push_back({start, start + length - 1});
-    }
-}
-
-std::vector<Interval> Almanac::applyMapToIntervals(
-    const RuleMap& map,
-    const std::vector<Interval>& input) {
-
-    std::vector<Interval> output;
-
-    // for each interval coming into this map
-    for (const Interval& interval : input) {
-
-        // track pieces that still need to be processed
-        std::vector<Interval> remaining;
-        remaining.push_back(interval);
-
-        // for each rule in current map
-        for (const Rule& rule : map.rules) {
-
-            std::vector<Interval> newRemaining;
-
-            // we try to match each remaining piece against this rule
-            for (const Interval& piece : remaining) {
-
-                long long a = piece.start;
-                long long b = piece.end;
-
-                long long r1 = rule.srcStart;
-                long long r2 = rule.srcEnd;
-
-                // compute overlap
-                long long overlapStart = std::max(a, r1);
-                long long overlapEnd = std::min(b, r2);
-
-                if (overlapStart <= overlapEnd) {
-
-                    // there is an overlap
-
-                    // (a) left remainder (not affected by rule)
-                    if (a < overlapStart) {
-                        newRemaining.push_back({a, overlapStart - 1});
-                    }
-
-                    // (b) overlapping part (we shift by delta)
-                    output.push_back({overlapStart + rule.delta, overlapEnd + rule.delta});
-
-                    // (c) right remainder (not affected by rule)
-                    if (overlapEnd < b) {
-                        newRemaining.push_back({overlapEnd + 1, b});
-                    }
-                }
-                else {
-
-                    // if no overlap, we keep piece unchanged for future rules
-                    newRemaining.push_back(piece);
-                }
-            }
-
-            // continue processing leftover pieces with next rule
-            remaining = newRemaining;
-        }
-
-        // after processing all rules,
-        // whatever is left was never mapped, so these simply map to themseleves
-        // so we add them unchanged
-        for (const Interval& piece : remaining) {
-            output.push_back(piece);
-        }
-    }
-
-    return output;
-}
-
-long long Almanac::getSolutionPart2() {
-
-    std::vector<Interval> current;
-
-    // build initial seed intervals
-    setSeedIntervals();
-
-    // push intervals through each map
-    for (const RuleMap& map : ruleMaps) {
-        seedIntervals = applyMapToIntervals(map, seedIntervals);
-    }
-
-    // find minimum start in final intervals
-    long long minimum = std::numeric_limits<long long>::max();
-
-    for (const Interval& interval : seedIntervals) {
-        minimum = std::min(minimum, interval.start);
-    }
-
-    return minimum;
-}
-
-
-
-
-
-
-
-
+#include "Almanac.h"
+#include "Instrumentation.h"
+#include "ThreadPool.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <limits>
+#include <queue>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+
+// ================================================================
+//                     SIMD LANES (batch evaluation)
+// ================================================================
+//
+// A block of 64-bit values processed together:
+//   - AVX-512: 8 lanes, masked compares + masked add
+//   - AVX2:    4 lanes, signed compares + byte blend
+//
+// Without either, the batch functions use the scalar path only.
+
+#if defined(__AVX512F__)
+
+#define ALMANAC_SIMD_LANES 8
+typedef __m512i SeedLanes;
+
+static inline SeedLanes loadLanes(const long long* p) { return _mm512_loadu_si512(p); }
+static inline void storeLanes(long long* p, SeedLanes v) { _mm512_storeu_si512(p, v); }
+static inline SeedLanes broadcastLanes(long long x) { return _mm512_set1_epi64(x); }
+static inline SeedLanes minLanes(SeedLanes a, SeedLanes b) {
+    return _mm512_mask_blend_epi64(_mm512_cmpgt_epi64_mask(a, b), a, b);
+}
+
+static inline SeedLanes applyRulesToLanes(const RuleMap& map, SeedLanes x) {
+
+    SeedLanes result = x;
+
+    // last to first, so the first matching rule is written last
+    for (int i = (int)map.rules.size() - 1; i >= 0; --i) {
+        const Rule& r = map.rules[i];
+        __mmask8 inside = _mm512_cmpge_epi64_mask(x, _mm512_set1_epi64(r.srcStart))
+                        & _mm512_cmple_epi64_mask(x, _mm512_set1_epi64(r.srcEnd));
+        result = _mm512_mask_add_epi64(result, inside, x, _mm512_set1_epi64(r.delta));
+    }
+
+    return result;
+}
+
+#elif defined(__AVX2__)
+
+#define ALMANAC_SIMD_LANES 4
+typedef __m256i SeedLanes;
+
+static inline SeedLanes loadLanes(const long long* p) { return _mm256_loadu_si256((const __m256i*)p); }
+static inline void storeLanes(long long* p, SeedLanes v) { _mm256_storeu_si256((__m256i*)p, v); }
+static inline SeedLanes broadcastLanes(long long x) { return _mm256_set1_epi64x(x); }
+
+static inline SeedLanes minLanes(SeedLanes a, SeedLanes b) {
+    return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+}
+
+static inline SeedLanes applyRulesToLanes(const RuleMap& map, SeedLanes x) {
+
+    SeedLanes result = x;
+
+    // last to first, so the first matching rule is written last
+    for (int i = (int)map.rules.size() - 1; i >= 0; --i) {
+        const Rule& r = map.rules[i];
+        __m256i outside = _mm256_or_si256(
+            _mm256_cmpgt_epi64(_mm256_set1_epi64x(r.srcStart), x),
+            _mm256_cmpgt_epi64(x, _mm256_set1_epi64x(r.srcEnd)));
+        __m256i shifted = _mm256_add_epi64(x, _mm256_set1_epi64x(r.delta));
+        result = _mm256_blendv_epi8(shifted, result, outside);
+    }
+
+    return result;
+}
+
+#else
+
+#define ALMANAC_SIMD_LANES 1
+
+#endif
+
+
+void Rule::printRule() const {
+
+    std::cout << "[srcStart, srcEnd, range] = " << "[" << srcStart << ", " << srcEnd << ", " << delta << "]\n";
+    std::cout << "Source Interval: [" << srcStart << ", " << srcEnd << "]\n";
+    std::cout << "Dest Interval: [" << (srcStart + delta) << ", " << (srcEnd + delta) << "]\n";
+
+    // destStart = srcStart + delta
+    // destEnd = srcEnd + delta
+}
+
+long long RuleMap::apply(long long x) const {
+
+    for (const auto& r : rules) {
+        if (x >= r.srcStart && x <= r.srcEnd)
+            return x + r.delta;
+    }
+    return x;
+}
+
+void RuleMap::splitInterval(const MappedInterval& in, std::vector<MappedInterval>& out) const {
+
+    const long long start = in.interval.start;
+    const long long end = in.interval.end;
+
+    if (disjoint && sortedStarts.size() == rules.size()) {
+
+        // first rule that can reach start: the last one starting at or before it
+        size_t k = std::upper_bound(sortedStarts.begin(), sortedStarts.end(), start) - sortedStarts.begin();
+        if (k > 0 && rules[sortedIndex[k - 1]].srcEnd >= start) k--;
+
+        long long from = start;
+
+        for (; k < sortedStarts.size() && sortedStarts[k] <= end; ++k) {
+
+            const Rule& rule = rules[sortedIndex[k]];
+
+            if (from < rule.srcStart)
+                out.push_back({{from, rule.srcStart - 1}, in.shift});
+
+            long long overlapStart = std::max(from, rule.srcStart);
+            long long overlapEnd = std::min(end, rule.srcEnd);
+            out.push_back({{overlapStart + rule.delta, overlapEnd + rule.delta}, in.shift + rule.delta});
+
+            if (overlapEnd == end) return;
+            from = overlapEnd + 1;
+        }
+
+        // unmatched tail maps to itself
+        out.push_back({{from, end}, in.shift});
+        return;
+    }
+
+    // overlapping rules: first match wins, so try them in priority order
+    thread_local std::vector<Interval> remaining, newRemaining;
+
+    remaining.assign(1, in.interval);
+
+    for (const Rule& rule : rules) {
+
+        newRemaining.clear();
+
+        for (const Interval& piece : remaining) {
+
+            long long overlapStart = std::max(piece.start, rule.srcStart);
+            long long overlapEnd = std::min(piece.end, rule.srcEnd);
+
+            if (overlapStart > overlapEnd) {
+                newRemaining.push_back(piece);
+                continue;
+            }
+
+            if (piece.start < overlapStart)
+                newRemaining.push_back({piece.start, overlapStart - 1});
+
+            out.push_back({{overlapStart + rule.delta, overlapEnd + rule.delta}, in.shift + rule.delta});
+
+            if (overlapEnd < piece.end)
+                newRemaining.push_back({overlapEnd + 1, piece.end});
+        }
+
+        remaining.swap(newRemaining);
+        if (remaining.empty()) return;
+    }
+
+    // unmatched pieces map to themselves
+    for (const Interval& piece : remaining)
+        out.push_back({piece, in.shift});
+}
+
+long long RuleMap::lowestImageFrom(long long x) const {
+
+    if (bounds.size() == rules.size() + 1) {
+
+        // bounds[k] covers the k rules starting at or before x
+        size_t k = std::upper_bound(sortedStarts.begin(), sortedStarts.end(), x) - sortedStarts.begin();
+        const RuleBound& b = bounds[k];
+
+        if (b.reach < x)
+            return std::min(x, b.minImageAfter);
+
+        return std::min({b.nextUncovered, x + b.straddleDelta, b.minImageAfter});
+    }
+
+    // no index: smallest mapped value of every rule reaching x or beyond,
+    // and x for the identity part
+    long long lowest = x;
+    for (const Rule& r : rules) {
+        if (r.srcEnd >= x)
+            lowest = std::min(lowest, std::max(x, r.srcStart) + r.delta);
+    }
+
+    return lowest;
+}
+
+// removes the values of 'cut' from a list of disjoint intervals
+static void subtractInterval(std::vector<Interval>& pieces, const Interval& cut) {
+
+    std::vector<Interval> kept;
+
+    for (const Interval& piece : pieces) {
+
+        if (cut.end < piece.start || cut.start > piece.end) {
+            kept.push_back(piece);
+            continue;
+        }
+
+        if (piece.start < cut.start)
+            kept.push_back({piece.start, cut.start - 1});
+
+        if (cut.end < piece.end)
+            kept.push_back({cut.end + 1, piece.end});
+    }
+
+    pieces = kept;
+}
+
+std::vector<Interval> RuleMap::preimage(const Interval& target) const {
+
+    std::vector<Interval> sources;
+
+    for (int i = 0; i < (int)rules.size(); ++i) {
+
+        const Rule& rule = rules[i];
+
+        // part of the destination interval inside the target
+        long long destStart = std::max(target.start, rule.srcStart + rule.delta);
+        long long destEnd = std::min(target.end, rule.srcEnd + rule.delta);
+
+        if (destStart > destEnd) continue;
+
+        // shift back into source space
+        std::vector<Interval> pieces = { {destStart - rule.delta, destEnd - rule.delta} };
+
+        // inputs of earlier rules never reach this one
+        for (int j = 0; j < i; ++j)
+            subtractInterval(pieces, {rules[j].srcStart, rules[j].srcEnd});
+
+        sources.insert(sources.end(), pieces.begin(), pieces.end());
+    }
+
+    // identity part: target values not inside any source interval
+    std::vector<Interval> identity = { target };
+    for (const Rule& rule : rules)
+        subtractInterval(identity, {rule.srcStart, rule.srcEnd});
+
+    sources.insert(sources.end(), identity.begin(), identity.end());
+
+    return sources;
+}
+
+void RuleMap::applyBatch(long long* values, size_t count) const {
+
+    size_t i = 0;
+
+#if ALMANAC_SIMD_LANES > 1
+    for (; i + ALMANAC_SIMD_LANES <= count; i += ALMANAC_SIMD_LANES)
+        storeLanes(values + i, applyRulesToLanes(*this, loadLanes(values + i)));
+#endif
+
+    // scalar tail
+    for (; i < count; ++i)
+        values[i] = apply(values[i]);
+}
+
+void RuleMap::buildIndex() {
+
+    sortedIndex.resize(rules.size());
+    for (int i = 0; i < (int)rules.size(); ++i)
+        sortedIndex[i] = i;
+
+    std::stable_sort(sortedIndex.begin(), sortedIndex.end(),
+        [this](int a, int b) { return rules[a].srcStart < rules[b].srcStart; });
+
+    // overlap exists iff some rule starts before an earlier one ends
+    disjoint = true;
+    long long reach = std::numeric_limits<long long>::min();
+
+    for (int k = 0; k < (int)sortedIndex.size(); ++k) {
+        const Rule& r = rules[sortedIndex[k]];
+        if (k > 0 && r.srcStart <= reach)
+            disjoint = false;
+        reach = std::max(reach, r.srcEnd);
+    }
+
+    buildBounds();
+}
+
+void RuleMap::buildBounds() {
+
+    const size_t n = sortedIndex.size();
+
+    sortedStarts.resize(n);
+    bounds.resize(n + 1);
+
+    bounds[0].reach = std::numeric_limits<long long>::min();
+    bounds[0].nextUncovered = std::numeric_limits<long long>::min();
+    bounds[0].straddleDelta = std::numeric_limits<long long>::max();
+
+    // prefixes: reach, covered block so far and straddling delta of the first k rules
+    long long blockEnd = std::numeric_limits<long long>::min();
+
+    for (size_t k = 0; k < n; ++k) {
+
+        const Rule& r = rules[sortedIndex[k]];
+        sortedStarts[k] = r.srcStart;
+
+        // a rule starting right after the covered block extends it
+        if (k == 0 || r.srcStart > blockEnd + 1) blockEnd = r.srcEnd;
+        else blockEnd = std::max(blockEnd, r.srcEnd);
+
+        RuleBound& b = bounds[k + 1];
+        b.reach = std::max(bounds[k].reach, r.srcEnd);
+        b.nextUncovered = blockEnd + 1;
+        b.straddleDelta = disjoint ? r.delta : std::min(bounds[k].straddleDelta, r.delta);
+    }
+
+    // suffixes: smallest image of the rules starting after x, and the end
+    // of each covered block including the rules that extend it later
+    bounds[n].minImageAfter = std::numeric_limits<long long>::max();
+    for (size_t k = n; k-- > 0;) {
+        const Rule& r = rules[sortedIndex[k]];
+        bounds[k].minImageAfter = std::min(bounds[k + 1].minImageAfter, r.srcStart + r.delta);
+        if (k > 0 && r.srcStart <= bounds[k].nextUncovered)
+            bounds[k].nextUncovered = bounds[k + 1].nextUncovered;
+    }
+}
+
+long long RuleMap::applyIndexed(long long x) const {
+
+    if (!disjoint || sortedIndex.size() != rules.size())
+        return apply(x);
+
+    // last rule starting at or before x
+    auto it = std::upper_bound(sortedIndex.begin(), sortedIndex.end(), x,
+        [this](long long value, int r) { return value < rules[r].srcStart; });
+
+    if (it == sortedIndex.begin())
+        return x;
+
+    const Rule& r = rules[*(it - 1)];
+    return x <= r.srcEnd ? x + r.delta : x;
+}
+
+void RuleMap::insertRule(int position, const Rule& rule) {
+
+    if (sortedIndex.size() != rules.size())
+        buildIndex();
+
+    rules.insert(rules.begin() + position, rule);
+
+    // later rules move one position down
+    for (int& r : sortedIndex)
+        if (r >= position) r++;
+
+    auto it = std::lower_bound(sortedIndex.begin(), sortedIndex.end(), rule.srcStart,
+        [this](int r, long long value) { return rules[r].srcStart < value; });
+    it = sortedIndex.insert(it, position);
+
+    // sorted disjoint rules: only the neighbours can overlap the new one
+    if (disjoint) {
+        if (it != sortedIndex.begin() && rules[*(it - 1)].srcEnd >= rule.srcStart)
+            disjoint = false;
+        if (it + 1 != sortedIndex.end() && rules[*(it + 1)].srcStart <= rule.srcEnd)
+            disjoint = false;
+    }
+
+    buildBounds();
+}
+
+void RuleMap::eraseRule(int position) {
+
+    if (sortedIndex.size() != rules.size())
+        buildIndex();
+
+    rules.erase(rules.begin() + position);
+
+    sortedIndex.erase(std::find(sortedIndex.begin(), sortedIndex.end(), position));
+    for (int& r : sortedIndex)
+        if (r > position) r--;
+
+    // removing a rule can only resolve overlaps
+    if (!disjoint)
+        buildIndex();
+    else
+        buildBounds();
+}
+
+void RuleMap::printRuleMap() const {
+    std::cout << "Rule '" << name << "' (" << rules.size() << " rules)\n";
+}
+
+
+
+Almanac::Almanac(const std::string& input)
+    : puzzleInput(input)
+{}
+
+void Almanac::readPuzzleInput() {
+
+    // plain, gzip or zstd; lines arrive through consumeLine()
+    if (!readChunked(puzzleInput, *this))
+        throw std::runtime_error("cannot read " + puzzleInput);
+}
+
+void Almanac::consumeLine(const std::string& line) {
+
+    bool detail = false;
+
+    // blank lines separate sections -> skip
+    if (line.empty()) return;
+
+    // if line starts with "seeds:"
+    if (line.rfind("seeds:", 0) == 0) {
+
+        // extract numbers after colon
+        std::stringstream ss(line.substr(6));
+        long long x;
+        // push into seeds vector
+        while (ss >> x)
+            seeds.push_back(x);
+        return;
+    }
+
+    // if line contains "map:"
+    if (line.find("map:") != std::string::npos) {
+
+        // if already in map section
+        if (parsingInMap) {
+            ruleMaps.push_back(parsingMap);  // save it
+            parsingMap = RuleMap{};          // start a new map
+        }
+
+        parsingInMap = true;
+        parsingMap.name = line;   // save name (optional)
+        return;
+    }
+
+    // if we are in map section, in numeric line
+    if (parsingInMap) {
+
+        // read values
+        std::stringstream ss(line);
+        long long destStart, srcStart, length;
+        ss >> destStart >> srcStart >> length;
+
+        // build the rule and convert: destStart sourceStart delta
+        // into:
+        //  - source interval
+        //  - delta offset
+
+        Rule r;
+        r.srcStart = srcStart;
+        r.srcEnd = srcStart + length - 1; // inclusive
+        r.delta = destStart - srcStart;
+
+        if (detail) r.printRule();
+
+        // save the rule
+        parsingMap.rules.push_back(r);
+    }
+}
+
+void Almanac::finishInput() {
+
+    bool detail = false;
+
+    // after finishing line, we push back last map
+    // since there is no blank line after the final block
+    if (parsingInMap) {
+        ruleMaps.push_back(parsingMap);
+        if (detail) parsingMap.printRuleMap();
+        parsingMap = RuleMap{};
+        parsingInMap = false;
+    }
+
+    // sorted lookup index for each map
+    for (RuleMap& map : ruleMaps)
+        map.buildIndex();
+
+    // cached stages describe the previous contents
+    resetIncrementalCache();
+
+    if (detail) {
+        std::cout << "Total seeds read from file: " << seeds.size() << std::endl;
+        std::cout << "Total rule maps: " << ruleMaps.size() << std::endl;
+    }
+
+}
+
+long long Almanac::applySingleSeed(long long seed) {
+
+    long long value = seed;
+
+    for (const auto& map : ruleMaps)
+        value = map.apply(value);
+
+    return value;
+}
+
+long long Almanac::getSolutionPart1() const {
+
+    return minLocationBatch(seeds.data(), seeds.size());
+}
+
+void Almanac::applySeedBatch(const long long* seeds, long long* locations, size_t count) const {
+
+    size_t i = 0;
+
+#if ALMANAC_SIMD_LANES > 1
+    for (; i + ALMANAC_SIMD_LANES <= count; i += ALMANAC_SIMD_LANES) {
+        SeedLanes v = loadLanes(seeds + i);
+        for (const RuleMap& map : ruleMaps)
+            v = applyRulesToLanes(map, v);
+        storeLanes(locations + i, v);
+    }
+#endif
+
+    // scalar tail
+    for (; i < count; ++i) {
+        long long value = seeds[i];
+        for (const RuleMap& map : ruleMaps)
+            value = map.apply(value);
+        locations[i] = value;
+    }
+}
+
+long long Almanac::minLocationBatch(const long long* seeds, size_t count) const {
+
+    long long minimumValue = std::numeric_limits<long long>::max();
+    size_t i = 0;
+
+#if ALMANAC_SIMD_LANES > 1
+    if (count >= ALMANAC_SIMD_LANES) {
+
+        SeedLanes minimumLanes = broadcastLanes(minimumValue);
+
+        for (; i + ALMANAC_SIMD_LANES <= count; i += ALMANAC_SIMD_LANES) {
+            SeedLanes v = loadLanes(seeds + i);
+            for (const RuleMap& map : ruleMaps)
+                v = applyRulesToLanes(map, v);
+            minimumLanes = minLanes(minimumLanes, v);
+        }
+
+        // horizontal minimum of the lanes
+        long long lanes[ALMANAC_SIMD_LANES];
+        storeLanes(lanes, minimumLanes);
+        for (long long location : lanes)
+            minimumValue = std::min(minimumValue, location);
+    }
+#endif
+
+    // scalar tail
+    for (; i < count; ++i) {
+        long long value = seeds[i];
+        for (const RuleMap& map : ruleMaps)
+            value = map.apply(value);
+        minimumValue = std::min(minimumValue, value);
+    }
+
+    return minimumValue;
+}
+
+
+void Almanac::setSeedIntervals() {
+
+    seedIntervals.clear();
+
+    for (int i = 0; i + 1 < (int)seeds.size(); i += 2) {
+        long long start = seeds[i];
+        long long length = seeds[i+1];
+
+        if (length > 0)
+            seedIntervals.push_back({start, start + length - 1});
+    }
+}
+
+// appends to an arena buffer, counting every reallocation
+static inline void pushInterval(std::vector<Interval>& buffer, const Interval& interval, IntervalArena& arena) {
+
+    if (buffer.size() == buffer.capacity())
+        arena.growths++;
+
+    buffer.push_back(interval);
+}
+
+void Almanac::applyMapInArena(const RuleMap& map, IntervalArena& arena) const {
+
+    std::vector<Interval>& output = arena.back;
+    output.clear();
+
+    // for each interval coming into this map
+    for (const Interval& interval : arena.front) {
+
+        // track pieces that still need to be processed
+        std::vector<Interval>& remaining = arena.remaining;
+        remaining.clear();
+        pushInterval(remaining, interval, arena);
+
+        // for each rule in current map
+        for (const Rule& rule : map.rules) {
+
+            std::vector<Interval>& newRemaining = arena.newRemaining;
+            newRemaining.clear();
+
+            // we try to match each remaining piece against this rule
+            for (const Interval& piece : remaining) {
+
+                long long a = piece.start;
+                long long b = piece.end;
+
+                long long r1 = rule.srcStart;
+                long long r2 = rule.srcEnd;
+
+                // compute overlap
+                long long overlapStart = std::max(a, r1);
+                long long overlapEnd = std::min(b, r2);
+
+                if (overlapStart <= overlapEnd) {
+
+                    // there is an overlap
+
+                    // (a) left remainder (not affected by rule)
+                    if (a < overlapStart) {
+                        pushInterval(newRemaining, {a, overlapStart - 1}, arena);
+                        AOC_COUNT(Day5IntervalSplits, 1);
+                    }
+
+                    // (b) overlapping part (we shift by delta)
+                    pushInterval(output, {overlapStart + rule.delta, overlapEnd + rule.delta}, arena);
+
+                    // (c) right remainder (not affected by rule)
+                    if (overlapEnd < b) {
+                        pushInterval(newRemaining, {overlapEnd + 1, b}, arena);
+                        AOC_COUNT(Day5IntervalSplits, 1);
+                    }
+                }
+                else {
+
+                    // if no overlap, we keep piece unchanged for future rules
+                    pushInterval(newRemaining, piece, arena);
+                }
+            }
+
+            // continue processing leftover pieces with next rule
+            // (swap keeps both buffers' capacity)
+            std::swap(arena.remaining, arena.newRemaining);
+        }
+
+        // after processing all rules,
+        // whatever is left was never mapped, so these simply map to themseleves
+        // so we add them unchanged
+        for (const Interval& piece : arena.remaining) {
+            pushInterval(output, piece, arena);
+        }
+    }
+
+    // output becomes the input of the next stage
+    std::swap(arena.front, arena.back);
+}
+
+std::vector<Interval> Almanac::applyMapToIntervals(
+    const RuleMap& map,
+    const std::vector<Interval>& input) const {
+
+    IntervalArena arena;
+    arena.front = input;
+
+    applyMapInArena(map, arena);
+
+    return arena.front;
+}
+
+long long Almanac::getSolutionPart2() {
+
+    return getSolutionPart2(intervalArena);
+}
+
+long long Almanac::getSolutionPart2(IntervalArena& arena) const {
+
+    size_t growthsBefore = arena.growths;
+
+    // seed intervals straight from the pairs, seedIntervals is not touched
+    arena.front.clear();
+    for (int i = 0; i + 1 < (int)seeds.size(); i += 2)
+        if (seeds[i+1] > 0)
+            pushInterval(arena.front, {seeds[i], seeds[i] + seeds[i+1] - 1}, arena);
+
+    // push intervals through each map
+
+    for (const RuleMap& map : ruleMaps) {
+        applyMapInArena(map, arena);
+    }
+
+    // find minimum start in final intervals
+    long long minimum = std::numeric_limits<long long>::max();
+
+    for (const Interval& interval : arena.front) {
+        minimum = std::min(minimum, interval.start);
+    }
+
+    arena.runs++;
+    arena.lastRunGrowths = arena.growths - growthsBefore;
+
+    return minimum;
+}
+
+// shared by the tasks of one getSolutionPart2Parallel() call; tasks hold
+// it by shared_ptr, so one starting after the call returned finds it closed
+struct PartitionRun {
+    std::mutex mutex;
+    std::condition_variable idle;
+    std::atomic<size_t> nextPartition{0};
+    int active = 0;
+    bool closed = false;
+    long long minimum = std::numeric_limits<long long>::max();
+};
+
+long long Almanac::getSolutionPart2Parallel(ThreadPool& pool, long long maxPartitionLength) const {
+
+    std::vector<Interval> ranges;
+    for (int i = 0; i + 1 < (int)seeds.size(); i += 2)
+        if (seeds[i+1] > 0)
+            ranges.push_back({seeds[i], seeds[i] + seeds[i+1] - 1});
+
+    int participants = pool.size() + 1;
+
+    // default: roughly 4 tasks per participant
+    if (maxPartitionLength <= 0) {
+        long long total = 0;
+        for (const Interval& interval : ranges)
+            total += interval.end - interval.start + 1;
+        maxPartitionLength = std::max(1LL, total / (4LL * participants));
+    }
+
+    // cut the seed ranges into independent tasks
+    std::vector<Interval> partitions;
+    for (const Interval& interval : ranges) {
+        for (long long start = interval.start; start <= interval.end; start += maxPartitionLength) {
+            long long end = std::min(interval.end, start + maxPartitionLength - 1);
+            partitions.push_back({start, end});
+            if (end == interval.end) break;
+        }
+    }
+
+    auto run = std::make_shared<PartitionRun>();
+
+    auto work = [this, &partitions](PartitionRun& r) {
+
+        // interval buffers of this participant, reused across partitions
+        IntervalArena arena;
+        long long minimum = std::numeric_limits<long long>::max();
+
+        for (size_t p = r.nextPartition++; p < partitions.size(); p = r.nextPartition++) {
+
+            arena.front.assign(1, partitions[p]);
+            for (const RuleMap& map : ruleMaps)
+                applyMapInArena(map, arena);
+
+            for (const Interval& interval : arena.front)
+                minimum = std::min(minimum, interval.start);
+        }
+
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.minimum = std::min(r.minimum, minimum);
+    };
+
+    for (int t = 0; t < pool.size(); ++t) {
+        pool.submit([run, work]() {
+            {
+                std::lock_guard<std::mutex> lock(run->mutex);
+                if (run->closed) return;
+                run->active++;
+            }
+            work(*run);
+
+            std::lock_guard<std::mutex> lock(run->mutex);
+            if (--run->active == 0) run->idle.notify_all();
+        });
+    }
+
+    // the calling thread works too, then waits only for tasks already running
+    work(*run);
+
+    std::unique_lock<std::mutex> lock(run->mutex);
+    run->closed = true;
+    run->idle.wait(lock, [&] { return run->active == 0; });
+
+    return run->minimum;
+}
+
+
+long long Almanac::locationLowerBound(long long x, int stage) const {
+
+    for (int i = stage; i < (int)ruleMaps.size(); ++i)
+        x = ruleMaps[i].lowestImageFrom(x);
+
+    return x;
+}
+
+std::vector<LocationHit> Almanac::getLowestLocations(int k) {
+
+    // queued interval keyed by the lower bound of its final locations
+    struct Node {
+        long long bound;
+        int stage;
+        MappedInterval piece;
+    };
+
+    auto worse = [](const Node& a, const Node& b) { return a.bound > b.bound; };
+    std::priority_queue<Node, std::vector<Node>, decltype(worse)> queue(worse);
+
+    setSeedIntervals();
+    for (const Interval& interval : seedIntervals)
+        queue.push({locationLowerBound(interval.start, 0), 0, {interval, 0}});
+
+    const int lastStage = (int)ruleMaps.size();
+    std::vector<LocationHit> hits;
+    std::vector<MappedInterval> pieces;
+
+    while (!queue.empty() && (int)hits.size() < k) {
+
+        Node node = queue.top();
+        queue.pop();
+
+        const Interval& interval = node.piece.interval;
+
+        // fully mapped and lowest bound: its start is proven minimal
+        if (node.stage == lastStage) {
+
+            hits.push_back({interval.start, interval.start - node.piece.shift});
+
+            if (interval.start < interval.end) {
+                node.bound = interval.start + 1;
+                node.piece.interval.start++;
+                queue.push(node);
+            }
+            continue;
+        }
+
+        // otherwise expand through the next map
+        pieces.clear();
+        ruleMaps[node.stage].splitInterval(node.piece, pieces);
+
+        for (const MappedInterval& p : pieces) {
+            int next = node.stage + 1;
+            queue.push({locationLowerBound(p.interval.start, next), next, p});
+        }
+    }
+
+    return hits;
+}
+
+long long Almanac::getSolutionPart2BestFirst() {
+
+    std::vector<LocationHit> hits = getLowestLocations(1);
+
+    if (hits.empty())
+        return std::numeric_limits<long long>::max();
+
+    return hits[0].location;
+}
+
+
+std::vector<Interval> Almanac::applyInverseMapToIntervals(
+    const RuleMap& map,
+    const std::vector<Interval>& input) const {
+
+    std::vector<Interval> output;
+
+    for (const Interval& interval : input) {
+        std::vector<Interval> sources = map.preimage(interval);
+        output.insert(output.end(), sources.begin(), sources.end());
+    }
+
+    return output;
+}
+
+std::vector<Interval> Almanac::seedsForLocations(const Interval& locations) const {
+
+    std::vector<Interval> current = { locations };
+
+    // walk the maps backwards: location -> ... -> seed
+    for (int i = (int)ruleMaps.size() - 1; i >= 0; --i)
+        current = applyInverseMapToIntervals(ruleMaps[i], current);
+
+    return current;
+}
+
+bool Almanac::isLocationReachable(const Interval& locations) const {
+
+    for (const Interval& seeds : seedsForLocations(locations)) {
+        for (const Interval& range : seedIntervals) {
+            if (std::max(seeds.start, range.start) <= std::min(seeds.end, range.end))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+long long Almanac::getSolutionPart2Inverse() {
+
+    setSeedIntervals();
+
+    if (seedIntervals.empty())
+        return std::numeric_limits<long long>::max();
+
+    // every location is a seed passed through unchanged or a rule destination
+    long long highest = std::numeric_limits<long long>::min();
+    for (const Interval& interval : seedIntervals)
+        highest = std::max(highest, interval.end);
+    for (const RuleMap& map : ruleMaps)
+        for (const Rule& r : map.rules)
+            highest = std::max(highest, r.srcEnd + r.delta);
+
+    // gallop upward: [0,0], [1,2], [3,6], ... until a block is reachable
+    long long lo = 0;
+    long long width = 1;
+    long long hi = 0;
+
+    while (true) {
+
+        if (lo > highest)
+            return std::numeric_limits<long long>::max();
+
+        hi = width - 1 > highest - lo ? highest : lo + width - 1;
+        if (isLocationReachable({lo, hi})) break;
+
+        lo = hi + 1;
+        width *= 2;
+    }
+
+    // bisect the block down to the lowest reachable location
+
+    while (lo < hi) {
+        long long mid = lo + (hi - lo) / 2;
+
+        if (isLocationReachable({lo, mid})) hi = mid;
+        else lo = mid + 1;
+    }
+
+    return lo;
+}
+
+
+void Almanac::markRuleChanged(int mapIndex, const Rule& rule) {
+
+    // Part 2 path: stages from this map onward are recomputed
+    firstDirtyStage = std::min(firstDirtyStage, mapIndex);
+
+    // Part 1 path: without cached values, the next call evaluates every seed anyway
+    if (seedStages.empty()) return;
+
+    changedRanges.resize(ruleMaps.size());
+    std::vector<Interval>& ranges = changedRanges[mapIndex];
+
+    // past this many ranges, re-evaluating every seed is cheaper than scanning them
+    if (ranges.size() >= maxChangedRanges) {
+        seedStages.clear();
+        changedRanges.clear();
+        return;
+    }
+
+    ranges.push_back({rule.srcStart, rule.srcEnd});
+}
+
+void Almanac::insertRule(int mapIndex, int position, const Rule& rule) {
+
+    ruleMaps[mapIndex].insertRule(position, rule);
+    markRuleChanged(mapIndex, rule);
+}
+
+void Almanac::eraseRule(int mapIndex, int position) {
+
+    Rule old = ruleMaps[mapIndex].rules[position];
+
+    ruleMaps[mapIndex].eraseRule(position);
+    markRuleChanged(mapIndex, old);
+}
+
+void Almanac::modifyRule(int mapIndex, int position, const Rule& rule) {
+
+    Rule old = ruleMaps[mapIndex].rules[position];
+
+    ruleMaps[mapIndex].eraseRule(position);
+    ruleMaps[mapIndex].insertRule(position, rule);
+
+    // values under both the old and the new source range may change
+    markRuleChanged(mapIndex, old);
+    markRuleChanged(mapIndex, rule);
+}
+
+void Almanac::resetIncrementalCache() {
+
+    seedStages.clear();
+    intervalStages.clear();
+    changedRanges.clear();
+    firstDirtyStage = 0;
+}
+
+long long Almanac::getSolutionPart1Incremental() {
+
+    const int n = (int)ruleMaps.size();
+    changedRanges.resize(n);
+
+    // no cache, or the seeds were replaced behind the rule API
+    if ((int)seedStages.size() != n + 1 || seedStages[0] != seeds) {
+
+        // first evaluation: fill every stage
+        seedStages.assign(n + 1, std::vector<long long>());
+        seedStages[0] = seeds;
+
+        for (int s = 0; s < n; ++s) {
+            seedStages[s + 1].resize(seeds.size());
+            for (int i = 0; i < (int)seeds.size(); ++i)
+                seedStages[s + 1][i] = ruleMaps[s].applyIndexed(seedStages[s][i]);
+        }
+    }
+    else {
+
+        // changed[i]: seed i has a new value at the current stage
+        std::vector<char> changed(seeds.size(), 0);
+
+        for (int s = 0; s < n; ++s) {
+
+            const std::vector<Interval>& ranges = changedRanges[s];
+
+            for (int i = 0; i < (int)seeds.size(); ++i) {
+
+                long long value = seedStages[s][i];
+
+                bool affected = changed[i];
+                for (int r = 0; !affected && r < (int)ranges.size(); ++r)
+                    affected = value >= ranges[r].start && value <= ranges[r].end;
+
+                if (!affected) continue;
+
+                long long next = ruleMaps[s].applyIndexed(value);
+                changed[i] = next != seedStages[s + 1][i];
+                seedStages[s + 1][i] = next;
+            }
+        }
+    }
+
+    for (std::vector<Interval>& ranges : changedRanges)
+        ranges.clear();
+
+    long long minimum = std::numeric_limits<long long>::max();
+    for (long long location : seedStages[n])
+        minimum = std::min(minimum, location);
+
+    return minimum;
+}
+
+long long Almanac::getSolutionPart2Incremental() {
+
+    const int n = (int)ruleMaps.size();
+
+    setSeedIntervals();
+
+    auto sameInterval = [](const Interval& a, const Interval& b) { return a.start == b.start && a.end == b.end; };
+
+    if ((int)intervalStages.size() != n + 1 ||
+        !std::equal(intervalStages[0].begin(), intervalStages[0].end(),
+                    seedIntervals.begin(), seedIntervals.end(), sameInterval)) {
+        intervalStages.assign(n + 1, std::vector<Interval>());
+        intervalStages[0] = seedIntervals;
+        firstDirtyStage = 0;
+    }
+
+    // recompute only the stages downstream of the first changed map
+    for (int s = firstDirtyStage; s < n; ++s) {
+        intervalArena.front = intervalStages[s];
+        applyMapInArena(ruleMaps[s], intervalArena);
+        intervalStages[s + 1] = intervalArena.front;
+    }
+
+    firstDirtyStage = n;
+
+    long long minimum = std::numeric_limits<long long>::max();
+    for (const Interval& interval : intervalStages[n])
+        minimum = std::min(minimum, interval.start);
+
+    return minimum;
+}
@@ -1,380 +1,883 @@
-#ifndef ALMANAC_H
-#define ALMANAC_H
-
-#include <string>
-#include <vector>
-#include <iostream>
-
-// Day 5 - If You Give A Seed A Fertilizer
-
-/*
-    === PART 1 ===
-
-We model the problem as a pipeline of piecewise-linear functions:
-
-    location = f7 ∘ f6 ∘ f5 ∘ ... ∘ f1 (seed)
-
-Each map defines a transformation:
-
-    destStart sourceStart length
-
-This defines:
-
-    Source interval:      [sourceStart, sourceStart + length - 1]
-    Destination interval: [destStart, destStart + length - 1]
-
-For x inside the source interval:
-
-    x -> x + (destStart - sourceStart)
-
-For x outside all source intervals:
-
-    x -> x (identity)
-
-For each seed:
-    Apply all maps in order.
-    Take the minimum final location.
-*/
-
-
-/*
-    === PART 2 ===
-
-1. If dealing with intervals, the ranges of seeds becomes too large to process every single seed.
-   So instead of doing: value -> value
-                 we do: interval -> intervals(s)
-
-We define a new struct 'Interval' to represent (start, end] for each pair of seeds.
-
-2. We turn the seed pairs into Intervals of seeds.
-
-3. We then apply one map to many intervals, using a function such as:
-
-    vector<Interval> applyMapToIntervals
-        (const RuleMap& map, const vector<Interval>& inputIntervals);
-
-4. Meaning we build a new list:
-
-     vector<Interval> output
-
-   and then for every input interval [a,b] we process it against all rules.
-
-5. That is, for one interval [a,b] we keep a working list:
-
-    vector<Interval> remaining = { [a, b] }
-
-   Then for each rule in map.rules we process overlaps.
-
-6. We have to compute the intersections. For example, given:
-
-    interval = [x1,x2]
-    rule = [r1,r2]
-
-   We compute:
-
-    overlapStart = max(x1, r1)
-    overlapEnd = min(x2, r2)
-
-In the case that overlapStart <= overlapEnd ... we have an overlap.
-
-7. When there is an overlap, we split the interval into up to 3 pieces:
-
-    a) left remainder:
-       [x1, overlapStart - 1] (only if x1 < overlapStart)
-
-    b) overlapping mapped part (we shift by delta)
-       [overlapStart + delta, overlapEnd + delta]
-      We add this directly to output
-
-    c) right remainder:
-       [overlapEnd + 1, x2] (only if overlapEnd < x2)
-
-8. We do not recompute the overlapping piece, but only the leftover ones.
-
-9. The remaining intervals (the ones that never matched any rule) simply map to themselves.
-   So we simply add them unchanged to output.
-
-10. The answer is the minimum found.
-
-
-
-*/
-
-
-/**
- * @struct Rule
- * @brief Represents a single interval mapping rule.
- *
- * Each rule models a piecewise-linear transformation over a source interval.
-
- * A rule is derived from an input line of the form:
- *
- *      destStart sourceStart length
- *
- * This defines:
- *
- *      Source interval:      [srcStart, srcEnd]
- *      Destination interval: [srcStart + delta, srcEnd + delta]
- *
- * where:
- *
- *      srcEnd = srcStart + length - 1
- *      delta  = destStart - srcStart
- *
- * For any value x inside the source interval:
- *
- *      x → x + delta
- *
- * Values outside all source intervals are unaffected (identity mapping).
- */
-
-struct Rule {
-    long long srcStart;
-    long long srcEnd;
-    long long delta;
-
-
-    /**
-     * @brief Prints the rule for debugging purposes.
-     *
-     * Displays the source interval and corresponding destination interval.
-     */
-    void printRule() const;
-};
-
-
-
-/**
- * @struct RuleMap
- * @brief Represents a full category-to-category transformation.
- *
- * A RuleMap contains multiple Rule objects and models
- * a piecewise-defined function:
- *
- *      f : ℤ → ℤ
- *
- * For a given input value:
- *   - The first rule whose source interval contains the value applies.
- *   - If no rule applies, the value maps to itself (identity).
- *
- * Example:
- *   seed-to-soil
- *   soil-to-fertilizer
- *   fertilizer-to-water
- *   ...
- */
-
-struct RuleMap {
-    std::string name;
-    std::vector<Rule> rules;
-
-
-    /**
-     * @brief Applies this rule map to a single value.
-     *
-     * If the value lies within a rule's source interval,
-     * the corresponding delta offset is applied.
-     * Otherwise, the value is returned unchanged.
-     *
-     * @param x Input value.
-     * @return Transformed value after applying the rule map.
-     */
-    long long apply(long long x) const;
-
-    /**
-     * @brief Prints summary information about the rule map.
-     */
-    void printRuleMap() const;
-};
-
-
-/**
- * @class Almanac
- * @brief Solves Advent of Code 2023 - Day 5: If You Give A Seed A Fertilizer.
- *
- * Problem Model:
- *
- * The input describes a pipeline of piecewise-linear transformations:
- *
- *      location = f_n ∘ f_{n-1} ∘ ... ∘ f_1 (seed)
- *
- * Each map converts numbers from one category to the next
- * using interval-based offset rules.
- *
- * Part 1:
- *   - Apply all maps sequentially to each seed.
- *   - Compute the final location value.
- *   - Return the minimum location over all seeds.
- *
- * Design Strategy:
- *   Phase 1: Parse file into:
- *       - Vector of seed values
- *       - Ordered vector of RuleMap objects
- *
- *   Phase 2:
- *       - For each seed, apply maps in order
- *       - Track the minimum resulting location
- */
-
-
-
-/**
- * @struct Interval
- * @brief Represents a closed integer interval [start, end].
- *
- * Used in Part 2 to efficiently model large contiguous ranges
- * of seed values without enumerating individual seeds.
- *
- * Both endpoints are inclusive:
- *
- *      start ≤ x ≤ end
- */
-
-struct Interval {
-    long long start;
-    long long end;
-};
-
-
-
-class Almanac {
-
-public:
-
-    // ================================================================
-    //                     CLASS MEMEBERS
-    // ================================================================
-
-    /** @brief Path to the puzzle input file. */
-    std::string puzzleInput;
-
-    /** @brief Initial seed values read from the input. */
-    std::vector<long long> seeds;
-
-    /** @brief Ordered collection of all transformation maps. */
-    std::vector<RuleMap> ruleMaps;
-
-    std::vector<Interval> seedIntervals;
-
-
-
-
-    // ================================================================
-    //                     PART 1
-    // ================================================================
-
-    /**
-     * @brief Constructs the Almanac solver using the given input file.
-     *
-     * @param input Path to the puzzle input file.
-     */
-    Almanac(const std::string& input);
-
-    /**
-     * @brief Reads and parses the puzzle input file.
-     *
-     * Parsing behavior:
-     *   - Extract seed values from the "seeds:" line.
-     *   - Parse each map section.
-     *   - Convert each numeric rule line into a Rule object.
-     *
-     * The rule maps are stored in file order to preserve
-     * correct functional composition.
-     */
-    void readPuzzleInput();
-
-    /**
-     * @brief Applies the full chain of rule maps to a single seed.
-     *
-     * Starting from the given seed value, this method applies each
-     * RuleMap in sequence, transforming the value step by step
-     * until the final location number is obtained.
-     *
-     * This models functional composition:
-     *
-     *     location = f_n ∘ f_{n-1} ∘ ... ∘ f_1 (seed)
-     *
-     * @param seed The initial seed number.
-     * @return The final location number corresponding to the seed.
-     */
-    long long applySingleSeed(long long seed);
-
-    /**
-     * @brief Computes the solution to Part 1.
-     *
-     * For each seed listed in the input:
-     *   - Apply all rule maps in order.
-     *   - Compute the final location value.
-     *
-     * The answer is the minimum location value among all seeds.
-     *
-     * @return The lowest location number corresponding to any initial seed.
-     */
-    long long getSolutionPart1();
-
-
-
-    // ================================================================
-    //                     PART 2
-    // ================================================================
-
-
-    /**
-     * @brief Converts the raw seed list into seed intervals.
-     *
-     * In Part 2, the input "seeds:" line encodes ranges:
-     *
-     *      seeds: start1 length1 start2 length2 ...
-     *
-     * Each pair (start, length) defines a closed interval:
-     *
-     *      [start, start + length - 1]
-     *
-     * These intervals are stored in seedIntervals.
-     */
-    void setSeedIntervals();
-
-    /**
-     * @brief Applies a RuleMap to a collection of intervals.
-     *
-     * Instead of mapping single values (as in Part 1),
-     * this function maps entire intervals.
-     *
-     * For each input interval:
-     *   - It computes overlaps with each rule.
-     *   - Splits intervals into:
-     *         • left remainder (unmapped)
-     *         • overlapping mapped part (shifted by delta)
-     *         • right remainder (unmapped)
-     *
-     * Intervals that never overlap any rule
-     * map to themselves (identity).
-     *
-     * @param map The RuleMap to apply.
-     * @param input The current set of intervals.
-     * @return The transformed set of intervals after applying the map.
-     */
-    std::vector<Interval> applyMapToIntervals(
-        const RuleMap& map,
-        const std::vector<Interval>& input);
-
-    /**
-     * @brief Computes the solution to Part 2.
-     *
-     * Strategy:
-     *   1. Convert seed pairs into intervals.
-     *   2. Push intervals through each RuleMap in order.
-     *   3. Track resulting transformed intervals.
-     *   4. Return the minimum start value among final intervals.
-     *
-     * This avoids enumerating billions of seeds and instead
-     * performs interval splitting and transformation.
-     *
-     * @return The lowest location number reachable from any seed range.
-     */
-    long long getSolutionPart2();
-
-};
-
-
-#endif // ALMANAC_H
+#ifndef ALMANAC_H
+#define ALMANAC_H
+
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include "ChunkedReader.h"
+
+class ThreadPool;
+
+// Day 5 - If You Give A Seed A Fertilizer
+
+/*
+    === PART 1 ===
+
+We model the problem as a pipeline of piecewise-linear functions:
+
+    location = f7 ∘ f6 ∘ f5 ∘ ... ∘ f1 (seed)
+
+Each map defines a transformation:
+
+    destStart sourceStart length
+
+This defines:
+
+    Source interval:      [sourceStart, sourceStart + length - 1]
+    Destination interval: [destStart, destStart + length - 1]
+
+For x inside the source interval:
+
+    x -> x + (destStart - sourceStart)
+
+For x outside all source intervals:
+
+    x -> x (identity)
+
+For each seed:
+    Apply all maps in order.
+    Take the minimum final location.
+*/
+
+
+/*
+    === PART 2 ===
+
+1. If dealing with intervals, the ranges of seeds becomes too large to process every single seed.
+   So instead of doing: value -> value
+                 we do: interval -> intervals(s)
+
+We define a new struct 'Interval' to represent (start, end] for each pair of seeds.
+
+2. We turn the seed pairs into Intervals of seeds.
+
+3. We then apply one map to many intervals, using a function such as:
+
+    vector<Interval> applyMapToIntervals
+        (const RuleMap& map, const vector<Interval>& inputIntervals);
+
+4. Meaning we build a new list:
+
+     vector<Interval> output
+
+   and then for every input interval [a,b] we process it against all rules.
+
+5. That is, for one interval [a,b] we keep a working list:
+
+    vector<Interval> remaining = { [a, b] }
+
+   Then for each rule in map.rules we process overlaps.
+
+6. We have to compute the intersections. For example, given:
+
+    interval = [x1,x2]
+    rule = [r1,r2]
+
+   We compute:
+
+    overlapStart = max(x1, r1)
+    overlapEnd = min(x2, r2)
+
+In the case that overlapStart <= overlapEnd ... we have an overlap.
+
+7. When there is an overlap, we split the interval into up to 3 pieces:
+
+    a) left remainder:
+       [x1, overlapStart - 1] (only if x1 < overlapStart)
+
+    b) overlapping mapped part (we shift by delta)
+       [overlapStart + delta, overlapEnd + delta]
+      We add this directly to output
+
+    c) right remainder:
+       [overlapEnd + 1, x2] (only if overlapEnd < x2)
+
+8. We do not recompute the overlapping piece, but only the leftover ones.
+
+9. The remaining intervals (the ones that never matched any rule) simply map to themselves.
+   So we simply add them unchanged to output.
+
+10. The answer is the minimum found.
+
+
+
+*/
+
+
+/**
+ * @struct Interval
+ * @brief Represents a closed integer interval [start, end].
+ *
+ * Used in Part 2 to efficiently model large contiguous ranges
+ * of seed values without enumerating individual seeds.
+ *
+ * Both endpoints are inclusive:
+ *
+ *      start ≤ x ≤ end
+ */
+
+struct Interval {
+    long long start;
+    long long end;
+};
+
+
+/**
+ * @struct MappedInterval
+ * @brief An interval together with the total offset applied to it so far.
+ *
+ * Every piece produced by the pipeline is a translated sub-interval
+ * of some seed interval, so the original seeds can be recovered as:
+ *
+ *      seed = value - shift
+ */
+
+struct MappedInterval {
+    Interval interval;
+    long long shift;
+};
+
+
+/**
+ * @struct LocationHit
+ * @brief A location value together with a seed that reaches it.
+ */
+
+struct LocationHit {
+    long long location;
+    long long seed;
+};
+
+
+/**
+ * @struct IntervalArena
+ * @brief Reusable interval buffers for Part 2 stage processing.
+ *
+ * Holds a pair of ping-pong buffers (front = intervals entering a stage,
+ * back = intervals produced by it) plus the scratch lists used while
+ * splitting one interval against the rules.
+ *
+ * Buffers are cleared, never released, so once they have grown to the
+ * size of the largest stage, further runs perform no heap allocations.
+ * Every reallocation is counted in 'growths'.
+ */
+
+struct IntervalArena {
+    std::vector<Interval> front;
+    std::vector<Interval> back;
+    std::vector<Interval> remaining;
+    std::vector<Interval> newRemaining;
+
+    /** @brief Total number of buffer reallocations. */
+    size_t growths = 0;
+    /** @brief Buffer reallocations during the most recent run. */
+    size_t lastRunGrowths = 0;
+    /** @brief Number of complete Part 2 runs using this arena. */
+    size_t runs = 0;
+};
+
+
+/**
+ * @struct Rule
+ * @brief Represents a single interval mapping rule.
+ *
+ * Each rule models a piecewise-linear transformation over a source interval.
+
+ * A rule is derived from an input line of the form:
+ *
+ *      destStart sourceStart length
+ *
+ * This defines:
+ *
+ *      Source interval:      [srcStart, srcEnd]
+ *      Destination interval: [srcStart + delta, srcEnd + delta]
+ *
+ * where:
+ *
+ *      srcEnd = srcStart + length - 1
+ *      delta  = destStart - srcStart
+ *
+ * For any value x inside the source interval:
+ *
+ *      x → x + delta
+ *
+ * Values outside all source intervals are unaffected (identity mapping).
+ */
+
+struct Rule {
+    long long srcStart;
+    long long srcEnd;
+    long long delta;
+
+
+    /**
+     * @brief Prints the rule for debugging purposes.
+     *
+     * Displays the source interval and corresponding destination interval.
+     */
+    void printRule() const;
+};
+
+
+
+/**
+ * @struct RuleBound
+ * @brief Precomputed facts about the first k rules of a map, by srcStart.
+ *
+ * RuleMap::bounds[k] describes the rules at sortedIndex[0..k-1] (those
+ * starting at or before x, for the k found by one binary search) and
+ * the rules after them. Together they give RuleMap::lowestImageFrom
+ * without visiting any rule.
+ */
+
+struct RuleBound {
+    long long reach;           ///< Largest srcEnd of the first k rules.
+    long long nextUncovered;   ///< First value after the covered block holding rule k-1.
+    long long straddleDelta;   ///< Delta of rule k-1 (disjoint), else smallest delta of the first k.
+    long long minImageAfter;   ///< Smallest srcStart + delta of the rules from k on.
+};
+
+
+/**
+ * @struct RuleMap
+ * @brief Represents a full category-to-category transformation.
+ *
+ * A RuleMap contains multiple Rule objects and models
+ * a piecewise-defined function:
+ *
+ *      f : ℤ → ℤ
+ *
+ * For a given input value:
+ *   - The first rule whose source interval contains the value applies.
+ *   - If no rule applies, the value maps to itself (identity).
+ *
+ * Example:
+ *   seed-to-soil
+ *   soil-to-fertilizer
+ *   fertilizer-to-water
+ *   ...
+ */
+
+struct RuleMap {
+    std::string name;
+    std::vector<Rule> rules;
+
+    /** @brief Positions in 'rules' ordered by srcStart (see buildIndex). */
+    std::vector<int> sortedIndex;
+
+    /** @brief True if no two source intervals overlap. */
+    bool disjoint = true;
+
+    /** @brief srcStart of rules[sortedIndex[k]], for binary searches. */
+    std::vector<long long> sortedStarts;
+
+    /** @brief bounds[k] for k = 0..rules.size() (see RuleBound). */
+    std::vector<RuleBound> bounds;
+
+
+    /**
+     * @brief Applies this rule map to a single value.
+     *
+     * If the value lies within a rule's source interval,
+     * the corresponding delta offset is applied.
+     * Otherwise, the value is returned unchanged.
+     *
+     * @param x Input value.
+     * @return Transformed value after applying the rule map.
+     */
+    long long apply(long long x) const;
+
+    /**
+     * @brief Applies this rule map to a single interval, keeping offsets.
+     *
+     * Same splitting as Almanac::applyMapToIntervals, but every produced
+     * piece carries the accumulated shift of the input plus the delta
+     * of the rule that mapped it (0 for identity pieces).
+     *
+     * With disjoint indexed rules, only the rules overlapping the
+     * interval are visited, in srcStart order. Otherwise every rule is
+     * tried in priority order, on per-thread scratch lists.
+     *
+     * @param in  The interval to map.
+     * @param out Receives the mapped pieces (appended).
+     */
+    void splitInterval(const MappedInterval& in, std::vector<MappedInterval>& out) const;
+
+    /**
+     * @brief Lower bound on the image of all values y >= x.
+     *
+     * Returns a value L such that apply(y) >= L for every y >= x.
+     * Any image of a value >= x is then >= L, so the bound of one map
+     * is a valid input for the next and bounds chain over the pipeline.
+     *
+     * With bounds built, this is one binary search in sortedStarts:
+     * the lowest of the identity part (x, or nextUncovered if x is
+     * covered), of x + straddleDelta and of minImageAfter. Overlapping
+     * maps get a looser, still valid, bound. Without bounds, every rule
+     * is scanned.
+     *
+     * @param x Smallest input value considered.
+     * @return Lower bound of { apply(y) : y >= x }.
+     */
+    long long lowestImageFrom(long long x) const;
+
+    /**
+     * @brief Maps an interval of outputs back to the inputs producing them.
+     *
+     * Computes the preimage { x : apply(x) ∈ target } as a list of
+     * disjoint intervals. For every rule, the part of its destination
+     * interval inside the target is shifted back by -delta, minus the
+     * inputs already claimed by earlier rules (first match wins).
+     * Inputs not covered by any rule map to themselves, so the part of
+     * the target outside every source interval is its own preimage.
+     *
+     * @param target Interval of output values.
+     * @return Intervals of input values mapping into the target.
+     */
+    std::vector<Interval> preimage(const Interval& target) const;
+
+    /**
+     * @brief Applies this rule map to an array of values in place.
+     *
+     * Vectorized version of apply(): values are processed in blocks of
+     * 8 lanes (AVX-512) or 4 lanes (AVX2) of 64-bit integers. Every rule
+     * is tested against the whole block with a compare-and-blend, so no
+     * per-value branches remain. Rules are visited from last to first
+     * so the first matching rule wins, as in apply().
+     *
+     * Without AVX2 support at compile time, falls back to apply().
+     *
+     * @param values Values to transform.
+     * @param count  Number of values.
+     */
+    void applyBatch(long long* values, size_t count) const;
+
+    /**
+     * @brief Rebuilds sortedIndex, the disjoint flag and the bounds from scratch.
+     */
+    void buildIndex();
+
+    /**
+     * @brief Rebuilds sortedStarts and bounds from sortedIndex in O(r).
+     */
+    void buildBounds();
+
+    /**
+     * @brief Applies this rule map to a single value using sortedIndex.
+     *
+     * With disjoint rules, the only candidate is the last rule starting
+     * at or before x, found by binary search in O(log r).
+     * Falls back to apply() if the index is missing or rules overlap.
+     *
+     * @param x Input value.
+     * @return Transformed value after applying the rule map.
+     */
+    long long applyIndexed(long long x) const;
+
+    /**
+     * @brief Inserts a rule at a given priority position.
+     *
+     * Keeps sortedIndex and the disjoint flag up to date
+     * without rebuilding them; the bounds are rebuilt in O(r).
+     *
+     * @param position Position in 'rules' (0 = highest priority).
+     * @param rule The rule to insert.
+     */
+    void insertRule(int position, const Rule& rule);
+
+    /**
+     * @brief Removes the rule at a given position.
+     *
+     * Keeps sortedIndex, the disjoint flag and the bounds up to date.
+     *
+     * @param position Position in 'rules'.
+     */
+    void eraseRule(int position);
+
+    /**
+     * @brief Prints summary information about the rule map.
+     */
+    void printRuleMap() const;
+};
+
+
+/**
+ * @class Almanac
+ * @brief Solves Advent of Code 2023 - Day 5: If You Give A Seed A Fertilizer.
+ *
+ * Problem Model:
+ *
+ * The input describes a pipeline of piecewise-linear transformations:
+ *
+ *      location = f_n ∘ f_{n-1} ∘ ... ∘ f_1 (seed)
+ *
+ * Each map converts numbers from one category to the next
+ * using interval-based offset rules.
+ *
+ * Part 1:
+ *   - Apply all maps sequentially to each seed.
+ *   - Compute the final location value.
+ *   - Return the minimum location over all seeds.
+ *
+ * Design Strategy:
+ *   Phase 1: Parse file into:
+ *       - Vector of seed values
+ *       - Ordered vector of RuleMap objects
+ *
+ *   Phase 2:
+ *       - For each seed, apply maps in order
+ *       - Track the minimum resulting location
+ */
+
+class Almanac : public LineConsumer {
+
+public:
+
+    // ================================================================
+    //                     CLASS MEMEBERS
+    // ================================================================
+
+    /** @brief Path to the puzzle input file. */
+    std::string puzzleInput;
+
+    /** @brief Initial seed values read from the input. */
+    std::vector<long long> seeds;
+
+    /** @brief Ordered collection of all transformation maps. */
+    std::vector<RuleMap> ruleMaps;
+
+    /** @brief Seed ranges built from the seed pairs (Part 2). */
+    std::vector<Interval> seedIntervals;
+
+    /** @brief Interval buffers reused by getSolutionPart2() across runs. */
+    IntervalArena intervalArena;
+
+    /** @brief Map section being parsed by consumeLine(). */
+    RuleMap parsingMap;
+    /** @brief True once consumeLine() has seen the first "map:" header. */
+    bool parsingInMap = false;
+
+
+
+
+    // ================================================================
+    //                     PART 1
+    // ================================================================
+
+    /**
+     * @brief Constructs the Almanac solver using the given input file.
+     *
+     * @param input Path to the puzzle input file.
+     */
+    Almanac(const std::string& input);
+
+    /**
+     * @brief Reads and parses the puzzle input file.
+     *
+     * Parsing behavior:
+     *   - Extract seed values from the "seeds:" line.
+     *   - Parse each map section.
+     *   - Convert each numeric rule line into a Rule object.
+     *
+     * The rule maps are stored in file order to preserve
+     * correct functional composition.
+     *
+     * The file may be gzip or zstd compressed (see readChunked()).
+     *
+     * @throws std::runtime_error if the file cannot be read or decompressed.
+     */
+    void readPuzzleInput();
+
+    /**
+     * @brief Parses one input line (LineConsumer).
+     *
+     * Called by readChunked() for every line of the input.
+     */
+    void consumeLine(const std::string& line) override;
+
+    /** @brief Stores the last map section and builds the map indexes. */
+    void finishInput() override;
+
+    /**
+     * @brief Applies the full chain of rule maps to a single seed.
+     *
+     * Starting from the given seed value, this method applies each
+     * RuleMap in sequence, transforming the value step by step
+     * until the final location number is obtained.
+     *
+     * This models functional composition:
+     *
+     *     location = f_n ∘ f_{n-1} ∘ ... ∘ f_1 (seed)
+     *
+     * @param seed The initial seed number.
+     * @return The final location number corresponding to the seed.
+     */
+    long long applySingleSeed(long long seed);
+
+    /**
+     * @brief Computes the solution to Part 1.
+     *
+     * For each seed listed in the input:
+     *   - Apply all rule maps in order.
+     *   - Compute the final location value.
+     *
+     * The answer is the minimum location value among all seeds.
+     * Evaluated with minLocationBatch.
+     *
+     * @return The lowest location number corresponding to any initial seed.
+     */
+    long long getSolutionPart1() const;
+
+    /**
+     * @brief Applies the full chain of rule maps to an array of seeds.
+     *
+     * Each block of lanes is carried through all maps while it stays
+     * in registers (see RuleMap::applyBatch).
+     *
+     * @param seeds     Input seed values.
+     * @param locations Receives the location of each seed.
+     * @param count     Number of seeds.
+     */
+    void applySeedBatch(const long long* seeds, long long* locations, size_t count) const;
+
+    /**
+     * @brief Computes the minimum location over an array of seeds.
+     *
+     * Same as applySeedBatch followed by a minimum, with the running
+     * minimum fused into the final stage so no locations are stored.
+     *
+     * @param seeds Input seed values.
+     * @param count Number of seeds.
+     * @return The lowest location, or LLONG_MAX if count is 0.
+     */
+    long long minLocationBatch(const long long* seeds, size_t count) const;
+
+
+
+    // ================================================================
+    //                     PART 2
+    // ================================================================
+
+
+    /**
+     * @brief Converts the raw seed list into seed intervals.
+     *
+     * In Part 2, the input "seeds:" line encodes ranges:
+     *
+     *      seeds: start1 length1 start2 length2 ...
+     *
+     * Each pair (start, length) defines a closed interval:
+     *
+     *      [start, start + length - 1]
+     *
+     * These intervals are stored in seedIntervals. Pairs with a length
+     * of zero or less describe no seeds and are dropped.
+     */
+    void setSeedIntervals();
+
+    /**
+     * @brief Applies a RuleMap to the intervals held in an arena.
+     *
+     * Maps arena.front into arena.back using the splitting described
+     * in applyMapToIntervals, then swaps the two buffers so the result
+     * is in arena.front. All buffers are reused, nothing is freed.
+     *
+     * @param map The RuleMap to apply.
+     * @param arena Buffers holding the current set of intervals.
+     */
+    void applyMapInArena(const RuleMap& map, IntervalArena& arena) const;
+
+    /**
+     * @brief Applies a RuleMap to a collection of intervals.
+     *
+     * Instead of mapping single values (as in Part 1),
+     * this function maps entire intervals.
+     *
+     * For each input interval:
+     *   - It computes overlaps with each rule.
+     *   - Splits intervals into:
+     *         • left remainder (unmapped)
+     *         • overlapping mapped part (shifted by delta)
+     *         • right remainder (unmapped)
+     *
+     * Intervals that never overlap any rule
+     * map to themselves (identity).
+     *
+     * @param map The RuleMap to apply.
+     * @param input The current set of intervals.
+     * @return The transformed set of intervals after applying the map.
+     */
+    std::vector<Interval> applyMapToIntervals(
+        const RuleMap& map,
+        const std::vector<Interval>& input) const;
+
+    /**
+     * @brief Computes the solution to Part 2.
+     *
+     * Strategy:
+     *   1. Convert seed pairs into intervals.
+     *   2. Push intervals through each RuleMap in order.
+     *   3. Track resulting transformed intervals.
+     *   4. Return the minimum start value among final intervals.
+     *
+     * This avoids enumerating billions of seeds and instead
+     * performs interval splitting and transformation.
+     *
+     * Uses intervalArena, so repeated calls do not allocate.
+     *
+     * @return The lowest location number reachable from any seed range.
+     */
+    long long getSolutionPart2();
+
+    /**
+     * @brief Computes the solution to Part 2 using the given buffers.
+     *
+     * Updates arena.runs and arena.lastRunGrowths; a steady-state run
+     * reports lastRunGrowths == 0. Reads only seeds and ruleMaps, so
+     * threads with their own arenas can share one Almanac.
+     *
+     * @param arena Interval buffers reused across stages and runs.
+     * @return The lowest location number reachable from any seed range.
+     */
+    long long getSolutionPart2(IntervalArena& arena) const;
+
+    /**
+     * @brief Computes the solution to Part 2 on a thread pool.
+     *
+     * Seed ranges are independent until the final minimum, so:
+     *   1. The seed ranges are cut into partitions; ranges longer than
+     *      maxPartitionLength are split into sub-ranges.
+     *   2. One task per pool worker, plus the calling thread, take
+     *      partitions one at a time and push each through all ruleMaps
+     *      using their own buffers.
+     *   3. Each of them keeps a local minimum, reduced at the end.
+     *
+     * The pool is the caller's, so repeated queries start no threads.
+     * The caller only waits for tasks that have started: tasks the pool
+     * runs after the partitions are gone do nothing. It is therefore
+     * safe to call from inside a task of the same pool.
+     *
+     * @param pool Pool running the partitions.
+     * @param maxPartitionLength Longest sub-range given to one task
+     *        (0 = chosen so that every worker gets several tasks).
+     * @return The lowest location number reachable from any seed range.
+     */
+    long long getSolutionPart2Parallel(ThreadPool& pool, long long maxPartitionLength = 0) const;
+
+
+    // ================================================================
+    //                     PART 2 - BEST-FIRST SEARCH
+    // ================================================================
+
+    /**
+     * @brief Lower bound on the final location of any value >= x at a stage.
+     *
+     * Chains RuleMap::lowestImageFrom over ruleMaps[stage..n-1].
+     *
+     * @param x     Smallest value of the interval entering the stage.
+     * @param stage Number of maps already applied.
+     * @return Admissible lower bound on the resulting locations.
+     */
+    long long locationLowerBound(long long x, int stage) const;
+
+    /**
+     * @brief Returns the k lowest locations together with their seeds.
+     *
+     * Best-first (branch-and-bound) search over seed intervals:
+     *   - Each queued interval is keyed by locationLowerBound of its start.
+     *   - The interval with the lowest bound is expanded through the next map.
+     *   - A fully mapped interval at the top of the queue is proven minimal,
+     *     its start is reported and the rest [start + 1, end] is re-queued.
+     *
+     * Intervals whose bound never reaches the top of the queue are never
+     * expanded, so most of the pipeline output is never materialized.
+     *
+     * If several seeds reach the same location, each (location, seed)
+     * pair is reported separately.
+     *
+     * @param k Number of results requested.
+     * @return Up to k hits in increasing order of location.
+     */
+    std::vector<LocationHit> getLowestLocations(int k);
+
+    /**
+     * @brief Computes the solution to Part 2 using best-first search.
+     *
+     * Equivalent to getSolutionPart2(), but stops as soon as the
+     * smallest final interval is proven minimal.
+     *
+     * @return The lowest location number reachable from any seed range.
+     */
+    long long getSolutionPart2BestFirst();
+
+
+
+    // ================================================================
+    //                     PART 2 - INVERSE PIPELINE
+    // ================================================================
+
+    /**
+     * @brief Maps a set of intervals backwards through one RuleMap.
+     *
+     * Inverse of applyMapToIntervals: collects RuleMap::preimage
+     * of every input interval.
+     *
+     * @param map The RuleMap to invert.
+     * @param input Intervals in the map's destination space.
+     * @return Intervals in the map's source space.
+     */
+    std::vector<Interval> applyInverseMapToIntervals(
+        const RuleMap& map,
+        const std::vector<Interval>& input) const;
+
+    /**
+     * @brief Computes which seed values produce the given locations.
+     *
+     * Applies the inverse maps from the last one to the first:
+     *
+     *      seeds = f_1^-1 ∘ ... ∘ f_n^-1 (locations)
+     *
+     * The result is not restricted to the seed ranges of the input.
+     *
+     * @param locations Interval of location values.
+     * @return Intervals of seed values mapping into the locations.
+     */
+    std::vector<Interval> seedsForLocations(const Interval& locations) const;
+
+    /**
+     * @brief Checks whether any seed range reaches the given locations.
+     *
+     * @param locations Interval of location values.
+     * @return True if a seed in seedIntervals maps into the interval.
+     */
+    bool isLocationReachable(const Interval& locations) const;
+
+    /**
+     * @brief Computes the solution to Part 2 by walking locations upward.
+     *
+     * Starting from location 0, blocks of locations of doubling size
+     * are mapped back to seeds until one intersects seedIntervals.
+     * That block is then bisected down to the lowest single location.
+     *
+     * Locations are assumed non-negative, as in the puzzle input.
+     * No location can exceed the largest seed or rule destination end,
+     * so the walk stops there.
+     *
+     * @return The lowest location number reachable from any seed range,
+     *         or the largest long long if none is.
+     */
+    long long getSolutionPart2Inverse();
+
+
+
+    // ================================================================
+    //                     INCREMENTAL RULE UPDATES
+    // ================================================================
+
+    /**
+     * @brief Values of every seed after each stage (Part 1 cache).
+     *
+     * seedStages[s][i] = seed i after the first s maps,
+     * so seedStages[0] = seeds and seedStages[n] = locations.
+     */
+    std::vector<std::vector<long long>> seedStages;
+
+    /**
+     * @brief Intervals entering each stage (Part 2 cache).
+     *
+     * intervalStages[s] = seed intervals after the first s maps.
+     */
+    std::vector<std::vector<Interval>> intervalStages;
+
+    /**
+     * @brief Source ranges changed in each map since the last Part 1 evaluation.
+     *
+     * Only seeds whose value falls in one of these ranges (or already
+     * changed upstream) are re-evaluated by getSolutionPart1Incremental,
+     * which clears them. Nothing is recorded while seedStages is empty.
+     */
+    std::vector<std::vector<Interval>> changedRanges;
+
+    /**
+     * @brief Most ranges kept per map before the Part 1 cache is dropped.
+     *
+     * Bounds changedRanges when only Part 2 is being re-solved.
+     */
+    static constexpr size_t maxChangedRanges = 64;
+
+    /** @brief First stage whose cached intervals are out of date. */
+    int firstDirtyStage = 0;
+
+    /**
+     * @brief Inserts a rule into ruleMaps[mapIndex].
+     *
+     * @param mapIndex Index of the map to change.
+     * @param position Position of the rule in the map (priority order).
+     * @param rule The rule to insert.
+     */
+    void insertRule(int mapIndex, int position, const Rule& rule);
+
+    /**
+     * @brief Removes a rule from ruleMaps[mapIndex].
+     *
+     * @param mapIndex Index of the map to change.
+     * @param position Position of the rule in the map.
+     */
+    void eraseRule(int mapIndex, int position);
+
+    /**
+     * @brief Replaces a rule of ruleMaps[mapIndex].
+     *
+     * @param mapIndex Index of the map to change.
+     * @param position Position of the rule in the map.
+     * @param rule The new rule.
+     */
+    void modifyRule(int mapIndex, int position, const Rule& rule);
+
+    /**
+     * @brief Records that the source range of a rule in a map changed.
+     *
+     * Each incremental path consumes its own record: firstDirtyStage
+     * for Part 2, changedRanges for Part 1.
+     *
+     * @param mapIndex Index of the changed map.
+     * @param rule The inserted, removed or replaced rule.
+     */
+    void markRuleChanged(int mapIndex, const Rule& rule);
+
+    /**
+     * @brief Drops all cached stage results.
+     *
+     * Must be called after changing ruleMaps directly instead of
+     * through the rule API. Parsing and loadAlmanacBinary call it;
+     * the incremental solvers also notice replaced seeds themselves.
+     */
+    void resetIncrementalCache();
+
+    /**
+     * @brief Computes the solution to Part 1 reusing cached stage values.
+     *
+     * The first call evaluates every seed through every stage and caches
+     * the result. After rule updates, a seed is re-evaluated at stage s
+     * only if its value there lies in a changed source range of map s,
+     * or if its value changed at an earlier stage.
+     *
+     * @return The lowest location number corresponding to any initial seed.
+     */
+    long long getSolutionPart1Incremental();
+
+    /**
+     * @brief Computes the solution to Part 2 reusing cached stage intervals.
+     *
+     * Stages before the first changed map keep their cached intervals;
+     * only the stages from that map onward are recomputed.
+     *
+     * @return The lowest location number reachable from any seed range.
+     */
+    long long getSolutionPart2Incremental();
+
+};
+
+
+#endif // ALMANAC_H
@@ -0,0 +1,212 @@
+#include "AlmanacBinary.h"
+
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <vector>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// rules are stored and loaded as raw (srcStart, srcEnd, delta) triples
+static_assert(sizeof(Rule) == 3 * sizeof(long long), "Rule must be three packed 64-bit integers");
+static_assert(std::is_trivially_copyable<Rule>::value, "Rule must be trivially copyable");
+static_assert(sizeof(AlmanacBinaryHeader) % 8 == 0, "header must keep the payload 8-byte aligned");
+
+
+uint64_t almanacChecksum(const void* bytes, size_t count) {
+
+    const unsigned char* p = static_cast<const unsigned char*>(bytes);
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (size_t i = 0; i < count; ++i) {
+        hash ^= p[i];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+// appends the raw bytes of 'count' objects to the buffer
+template <typename T>
+static void appendBytes(std::vector<unsigned char>& buffer, const T* items, size_t count) {
+
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(items);
+    buffer.insert(buffer.end(), p, p + count * sizeof(T));
+}
+
+bool saveAlmanacBinary(const Almanac& almanac, const std::string& path) {
+
+    std::vector<AlmanacBinaryMap> maps;
+    std::vector<Rule> rules;
+    std::string names;
+
+    for (const RuleMap& map : almanac.ruleMaps) {
+        maps.push_back({rules.size(), map.rules.size(), names.size(), map.name.size()});
+        rules.insert(rules.end(), map.rules.begin(), map.rules.end());
+        names += map.name;
+    }
+
+    // pad the names so the file size stays a multiple of 8
+    names.resize((names.size() + 7) / 8 * 8, '\0');
+
+    std::vector<unsigned char> payload;
+    appendBytes(payload, almanac.seeds.data(), almanac.seeds.size());
+    appendBytes(payload, maps.data(), maps.size());
+    appendBytes(payload, rules.data(), rules.size());
+    appendBytes(payload, names.data(), names.size());
+
+    AlmanacBinaryHeader header;
+    std::memcpy(header.magic, ALMANAC_BINARY_MAGIC, sizeof(header.magic));
+    header.version = ALMANAC_BINARY_VERSION;
+    header.headerSize = sizeof(AlmanacBinaryHeader);
+    header.seedCount = almanac.seeds.size();
+    header.mapCount = maps.size();
+    header.ruleCount = rules.size();
+    header.nameBytes = names.size();
+    header.payloadBytes = payload.size();
+    header.checksum = almanacChecksum(payload.data(), payload.size());
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(payload.data()), payload.size());
+
+    if (!file) {
+        std::cerr << "Could not write binary almanac: " << path << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+AlmanacMapping::~AlmanacMapping() {
+    close();
+}
+
+void AlmanacMapping::close() {
+
+    if (data)
+        munmap(const_cast<unsigned char*>(data), size);
+
+    data = nullptr;
+    size = 0;
+}
+
+bool AlmanacMapping::open(const std::string& path, bool verifyChecksum) {
+
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Could not open binary almanac: " << path << std::endl;
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(AlmanacBinaryHeader)) {
+        std::cerr << "Binary almanac too small: " << path << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    void* mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+
+    if (mapped == MAP_FAILED) {
+        std::cerr << "Could not map binary almanac: " << path << std::endl;
+        return false;
+    }
+
+    data = static_cast<const unsigned char*>(mapped);
+    size = info.st_size;
+
+    // validate header and section sizes before touching the payload
+    const AlmanacBinaryHeader& h = header();
+
+    std::string problem;
+
+    if (std::memcmp(h.magic, ALMANAC_BINARY_MAGIC, sizeof(h.magic)) != 0)
+        problem = "bad magic";
+    else if (h.version != ALMANAC_BINARY_VERSION)
+        problem = "unsupported version " + std::to_string(h.version);
+    else if (h.headerSize != sizeof(AlmanacBinaryHeader))
+        problem = "bad header size";
+    else if (h.payloadBytes != size - sizeof(AlmanacBinaryHeader))
+        problem = "inconsistent section sizes";
+    // bound every count by the file before multiplying, so no product can wrap
+    else if (h.seedCount > h.payloadBytes / sizeof(long long)
+             || h.mapCount > h.payloadBytes / sizeof(AlmanacBinaryMap)
+             || h.ruleCount > h.payloadBytes / sizeof(Rule)
+             || h.nameBytes > h.payloadBytes)
+        problem = "section larger than the file";
+    else if (h.payloadBytes != h.seedCount * sizeof(long long)
+                                + h.mapCount * sizeof(AlmanacBinaryMap)
+                                + h.ruleCount * sizeof(Rule)
+                                + h.nameBytes)
+        problem = "inconsistent section sizes";
+    else if (verifyChecksum && almanacChecksum(data + sizeof(AlmanacBinaryHeader), h.payloadBytes) != h.checksum)
+        problem = "checksum mismatch";
+
+    if (problem.empty()) {
+        for (uint64_t i = 0; i < h.mapCount; ++i) {
+            const AlmanacBinaryMap& m = maps()[i];
+            if (m.firstRule > h.ruleCount || m.ruleCount > h.ruleCount - m.firstRule
+                || m.nameOffset > h.nameBytes || m.nameLength > h.nameBytes - m.nameOffset)
+                problem = "map out of range";
+        }
+    }
+
+    if (!problem.empty()) {
+        std::cerr << "Invalid binary almanac (" << problem << "): " << path << std::endl;
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+const long long* AlmanacMapping::seeds() const {
+    return reinterpret_cast<const long long*>(data + sizeof(AlmanacBinaryHeader));
+}
+
+const AlmanacBinaryMap* AlmanacMapping::maps() const {
+    return reinterpret_cast<const AlmanacBinaryMap*>(seeds() + header().seedCount);
+}
+
+const Rule* AlmanacMapping::rules() const {
+    return reinterpret_cast<const Rule*>(maps() + header().mapCount);
+}
+
+const char* AlmanacMapping::names() const {
+    return reinterpret_cast<const char*>(rules() + header().ruleCount);
+}
+
+
+bool loadAlmanacBinary(Almanac& almanac, const std::string& path, bool verifyChecksum) {
+
+    AlmanacMapping mapping;
+    if (!mapping.open(path, verifyChecksum))
+        return false;
+
+    const AlmanacBinaryHeader& h = mapping.header();
+
+    almanac.seeds.assign(mapping.seeds(), mapping.seeds() + h.seedCount);
+    almanac.ruleMaps.resize(h.mapCount);
+
+    for (uint64_t i = 0; i < h.mapCount; ++i) {
+        const AlmanacBinaryMap& m = mapping.maps()[i];
+        RuleMap& map = almanac.ruleMaps[i];
+        map.name.assign(mapping.names() + m.nameOffset, m.nameLength);
+        map.rules.assign(mapping.rules() + m.firstRule, mapping.rules() + m.firstRule + m.ruleCount);
+        map.buildIndex();
+    }
+
+    // cached stages describe the previous contents
+    almanac.resetIncrementalCache();
+
+    return true;
+}
@@ -0,0 +1,148 @@
+#ifndef ALMANAC_BINARY_H
+#define ALMANAC_BINARY_H
+
+#include "Almanac.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+// Day 5 - Precompiled (binary) almanac format
+
+/*
+    === FORMAT ===
+
+A parsed almanac is stored as one header followed by a payload.
+All fields are 64-bit aligned, little-endian, native integers:
+
+    header                       (AlmanacBinaryHeader)
+    seeds[seedCount]             int64
+    maps[mapCount]               (AlmanacBinaryMap)
+    rules[ruleCount]             (srcStart, srcEnd, delta) as int64
+    names[nameBytes]             map names, concatenated
+
+Rules keep their file order (first match wins), grouped by map.
+The checksum is a 64-bit FNV-1a hash of the payload bytes.
+
+Loading maps the file into memory, validates the header and checksum,
+and copies the arrays directly into an Almanac: no text is parsed.
+*/
+
+
+/** @brief Magic bytes at the start of every binary almanac. */
+static const char ALMANAC_BINARY_MAGIC[8] = { 'A', 'O', 'C', '5', 'A', 'L', 'M', 'B' };
+
+/** @brief Current format version; files with another version are rejected. */
+static const uint32_t ALMANAC_BINARY_VERSION = 1;
+
+
+/**
+ * @struct AlmanacBinaryHeader
+ * @brief Fixed-size header of a binary almanac file.
+ */
+
+struct AlmanacBinaryHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t seedCount;
+    uint64_t mapCount;
+    uint64_t ruleCount;
+    uint64_t nameBytes;
+    uint64_t payloadBytes;
+    uint64_t checksum;
+};
+
+
+/**
+ * @struct AlmanacBinaryMap
+ * @brief Location of one RuleMap's rules and name inside the payload.
+ */
+
+struct AlmanacBinaryMap {
+    uint64_t firstRule;
+    uint64_t ruleCount;
+    uint64_t nameOffset;
+    uint64_t nameLength;
+};
+
+
+/**
+ * @class AlmanacMapping
+ * @brief Read-only memory mapping of a binary almanac file.
+ *
+ * Gives zero-copy access to the stored arrays. The pointers stay
+ * valid for the lifetime of the mapping.
+ */
+
+class AlmanacMapping {
+
+public:
+
+    AlmanacMapping() = default;
+    ~AlmanacMapping();
+
+    AlmanacMapping(const AlmanacMapping&) = delete;
+    AlmanacMapping& operator=(const AlmanacMapping&) = delete;
+
+    /**
+     * @brief Maps a binary almanac file and validates it.
+     *
+     * Checks the magic bytes, version, section sizes and
+     * (if verifyChecksum) the payload checksum.
+     *
+     * @param path Path to the binary file.
+     * @param verifyChecksum If true, hashes the payload.
+     * @return True if the file is a valid binary almanac.
+     */
+    bool open(const std::string& path, bool verifyChecksum = true);
+
+    /** @brief Unmaps the file. */
+    void close();
+
+    const AlmanacBinaryHeader& header() const { return *reinterpret_cast<const AlmanacBinaryHeader*>(data); }
+    const long long* seeds() const;
+    const AlmanacBinaryMap* maps() const;
+    const Rule* rules() const;
+    const char* names() const;
+
+private:
+
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+};
+
+
+/**
+ * @brief Computes the 64-bit FNV-1a hash of a byte range.
+ *
+ * @param bytes Start of the range.
+ * @param count Number of bytes.
+ * @return The hash value.
+ */
+uint64_t almanacChecksum(const void* bytes, size_t count);
+
+/**
+ * @brief Writes the parsed seeds and ruleMaps of an almanac to a binary file.
+ *
+ * @param almanac A parsed Almanac (readPuzzleInput already called).
+ * @param path Output file path.
+ * @return True on success.
+ */
+bool saveAlmanacBinary(const Almanac& almanac, const std::string& path);
+
+/**
+ * @brief Loads seeds and ruleMaps from a binary file into an almanac.
+ *
+ * Replaces almanac.seeds and almanac.ruleMaps and drops the
+ * incremental caches; this takes the place of readPuzzleInput().
+ *
+ * @param almanac Almanac to fill.
+ * @param path Binary file path.
+ * @param verifyChecksum If true, hashes the payload before loading.
+ * @return True on success; the almanac is unchanged on failure.
+ */
+bool loadAlmanacBinary(Almanac& almanac, const std::string& path, bool verifyChecksum = true);
+
+
+#endif // ALMANAC_BINARY_H
@@ -0,0 +1,132 @@
+#include "AlmanacCodegen.h"
+
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+
+std::vector<AlmanacPiece> composeRuleMaps(const Almanac& almanac) {
+
+    std::vector<MappedInterval> current = { {{ALMANAC_PIECE_MIN, ALMANAC_PIECE_MAX}, 0} };
+    std::vector<MappedInterval> next;
+
+    for (const RuleMap& map : almanac.ruleMaps) {
+        next.clear();
+        for (const MappedInterval& piece : current)
+            map.splitInterval(piece, next);
+        current.swap(next);
+    }
+
+    // back to seed space: every piece is a shifted slice of the domain
+    std::vector<AlmanacPiece> shifted;
+    for (const MappedInterval& piece : current)
+        shifted.push_back({piece.interval.start - piece.shift, piece.shift});
+
+    std::sort(shifted.begin(), shifted.end(),
+              [](const AlmanacPiece& a, const AlmanacPiece& b) { return a.start < b.start; });
+
+    std::vector<AlmanacPiece> pieces;
+    for (const AlmanacPiece& piece : shifted)
+        if (pieces.empty() || pieces.back().delta != piece.delta)
+            pieces.push_back(piece);
+
+    return pieces;
+}
+
+// C++ string literal for arbitrary text
+static std::string quoted(const std::string& text) {
+
+    std::string out = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out + "\"";
+}
+
+// writes values as an initializer list, four per line
+template <typename T, typename Format>
+static void writeList(std::ostream& out, const std::vector<T>& values, Format format) {
+
+    out << "{";
+    if (values.empty()) out << " {}";
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        out << (i % 4 == 0 ? "\n        " : " ");
+        format(out, values[i]);
+        if (i + 1 < values.size()) out << ",";
+    }
+
+    out << "\n    };\n";
+}
+
+bool saveAlmanacHeader(const Almanac& almanac, const std::string& path, const std::string& source) {
+
+    std::vector<AlmanacPiece> pieces = composeRuleMaps(almanac);
+
+    std::vector<long long> starts, deltas;
+    for (const AlmanacPiece& piece : pieces) {
+        starts.push_back(piece.start);
+        deltas.push_back(piece.delta);
+    }
+
+    std::vector<std::string> names;
+    std::vector<size_t> ruleOffsets = { 0 };
+    std::vector<Rule> rules;
+
+    for (const RuleMap& map : almanac.ruleMaps) {
+        names.push_back(map.name);
+        rules.insert(rules.end(), map.rules.begin(), map.rules.end());
+        ruleOffsets.push_back(rules.size());
+    }
+
+    // zero-length arrays are not allowed; empty tables get one unused entry
+    auto extent = [](size_t count) { return std::max<size_t>(count, 1); };
+
+    std::ofstream out(path, std::ios::trunc);
+
+    out << "// Generated by day5_compile from " << source << " - do not edit.\n"
+        << "//\n"
+        << "// " << almanac.ruleMaps.size() << " maps, " << rules.size() << " rules, composed into "
+        << pieces.size() << " pieces (see AlmanacCodegen.h).\n\n"
+        << "#ifndef COMPILED_ALMANAC_H\n"
+        << "#define COMPILED_ALMANAC_H\n\n"
+        << "#include <cstddef>\n\n"
+        << "struct CompiledAlmanac {\n\n"
+        << "    static constexpr const char* source = " << quoted(source) << ";\n\n";
+
+    out << "    static constexpr size_t pieceCount = " << pieces.size() << ";\n"
+        << "    static constexpr long long starts[pieceCount] = ";
+    writeList(out, starts, [](std::ostream& o, long long v) {
+        if (v == ALMANAC_PIECE_MIN) o << "-(1LL << 62)";
+        else o << v << "LL";
+    });
+    out << "    static constexpr long long deltas[pieceCount] = ";
+    writeList(out, deltas, [](std::ostream& o, long long v) { o << v << "LL"; });
+
+    out << "\n    static constexpr size_t seedCount = " << almanac.seeds.size() << ";\n"
+        << "    static constexpr long long seeds[" << extent(almanac.seeds.size()) << "] = ";
+    writeList(out, almanac.seeds, [](std::ostream& o, long long v) { o << v << "LL"; });
+
+    out << "\n    static constexpr size_t mapCount = " << names.size() << ";\n"
+        << "    static constexpr const char* mapNames[" << extent(names.size()) << "] = ";
+    writeList(out, names, [](std::ostream& o, const std::string& v) { o << quoted(v); });
+    out << "    static constexpr size_t ruleOffsets[mapCount + 1] = ";
+    writeList(out, ruleOffsets, [](std::ostream& o, size_t v) { o << v; });
+
+    out << "\n    // srcStart, srcEnd, delta\n"
+        << "    static constexpr size_t ruleCount = " << rules.size() << ";\n"
+        << "    static constexpr long long rules[" << extent(rules.size()) << "][3] = ";
+    writeList(out, rules, [](std::ostream& o, const Rule& r) {
+        o << "{ " << r.srcStart << "LL, " << r.srcEnd << "LL, " << r.delta << "LL }";
+    });
+
+    out << "};\n\n"
+        << "#endif // COMPILED_ALMANAC_H\n";
+
+    if (!out) {
+        std::cerr << "Could not write almanac header: " << path << std::endl;
+        return false;
+    }
+
+    return true;
+}
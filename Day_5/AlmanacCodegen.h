@@ -0,0 +1,86 @@
+#ifndef ALMANAC_CODEGEN_H
+#define ALMANAC_CODEGEN_H
+
+#include "Almanac.h"
+
+#include <string>
+#include <vector>
+
+// Day 5 - Compiled almanac (rules baked into generated C++)
+
+/*
+    === COMPOSITION ===
+
+Every RuleMap is piecewise linear with slope 1, so the whole pipeline
+
+    location = f_n ∘ ... ∘ f_1 (seed)
+
+is too. Pushing the full domain through all maps with
+RuleMap::splitInterval cuts it into pieces, each carrying the total
+shift applied to it. Mapped back to seed space (value - shift), these
+pieces tile the domain:
+
+    seed x in [start_i, start_{i+1})  ->  location x + delta_i
+
+Neighbouring pieces with the same delta are merged.
+
+
+    === GENERATED HEADER ===
+
+saveAlmanacHeader() writes the pieces, the seeds and the original
+rules as constexpr arrays of one struct:
+
+    struct CompiledAlmanac {
+        pieceCount, starts[], deltas[]            composed pipeline
+        seedCount, seeds[]                        "seeds:" line
+        mapCount, mapNames[], ruleOffsets[],
+        ruleCount, rules[][3]                     the maps, in file order
+    };
+
+A program including it needs no input file at all; CompiledLookup.h
+evaluates the pieces with a search tree unrolled at compile time.
+*/
+
+
+/**
+ * @struct AlmanacPiece
+ * @brief One piece of the composed pipeline.
+ *
+ * Seeds from start up to the start of the next piece have
+ * location seed + delta.
+ */
+
+struct AlmanacPiece {
+    long long start;
+    long long delta;
+};
+
+
+/** @brief Smallest seed covered by the composed pieces. */
+static const long long ALMANAC_PIECE_MIN = -(1LL << 62);
+
+/** @brief Largest seed covered by the composed pieces. */
+static const long long ALMANAC_PIECE_MAX = (1LL << 62) - 1;
+
+
+/**
+ * @brief Composes all ruleMaps of an almanac into one piecewise function.
+ *
+ * @param almanac A parsed Almanac.
+ * @return Pieces sorted by start, the first one starting at
+ *         ALMANAC_PIECE_MIN; no two neighbours share a delta.
+ */
+std::vector<AlmanacPiece> composeRuleMaps(const Almanac& almanac);
+
+/**
+ * @brief Writes an almanac as a C++ header of constexpr tables.
+ *
+ * @param almanac A parsed Almanac (readPuzzleInput already called).
+ * @param path Output header path.
+ * @param source Name of the input, recorded in the header.
+ * @return True on success.
+ */
+bool saveAlmanacHeader(const Almanac& almanac, const std::string& path, const std::string& source);
+
+
+#endif // ALMANAC_CODEGEN_H
@@ -0,0 +1,37 @@
+#ifndef ALMANAC_SOLVER_H
+#define ALMANAC_SOLVER_H
+
+#include "Solver.h"
+#include "Almanac.h"
+
+
+/**
+ * @class AlmanacSolver
+ * @brief Day 5 on the Solver interface; the model is a parsed Almanac.
+ *
+ * Part 2 runs on a thread_local IntervalArena, so every thread reuses
+ * its own buffers and the shared model is never written.
+ */
+
+class AlmanacSolver : public Solver<AlmanacSolver> {
+public:
+
+    typedef Almanac Model;
+    static constexpr int day = 5;
+
+    Model parseInput(const std::string& path) const {
+        Model model(path);
+        readInput(path, model);
+        return model;
+    }
+
+    long long solvePart1(const Model& model) const { return model.getSolutionPart1(); }
+
+    long long solvePart2(const Model& model) const {
+        thread_local IntervalArena arena;
+        return model.getSolutionPart2(arena);
+    }
+};
+
+
+#endif // ALMANAC_SOLVER_H
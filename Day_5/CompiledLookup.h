@@ -0,0 +1,106 @@
+#ifndef COMPILED_LOOKUP_H
+#define COMPILED_LOOKUP_H
+
+#include <cstddef>
+#include <limits>
+
+// Day 5 - Lookups in a compiled almanac (see AlmanacCodegen.h)
+
+/*
+    === SEARCH TREE ===
+
+Finding the piece of a seed is a search for the last start <= x in a
+sorted table whose size is a compile-time constant. PieceSearch<Count>
+unrolls that search into one compare per level of a balanced tree:
+
+    base += (starts[base + half] <= x) * half
+
+Each level halves the candidates without a branch, so a lookup is
+log2(pieceCount) loads and adds, with no mispredictions whatever
+the seeds look like.
+
+Every function is constexpr: with a constant seed list, the compiler
+evaluates the answers while building the program.
+*/
+
+
+/**
+ * @struct PieceSearch
+ * @brief Branchless search among Count sorted starts beginning at base.
+ */
+
+template <size_t Count>
+struct PieceSearch {
+
+    static constexpr size_t half = Count / 2;
+
+    static constexpr size_t find(const long long* starts, size_t base, long long x) {
+        base += (size_t)(starts[base + half] <= x) * half;
+        return PieceSearch<Count - half>::find(starts, base, x);
+    }
+};
+
+template <>
+struct PieceSearch<1> {
+    static constexpr size_t find(const long long*, size_t base, long long) { return base; }
+};
+
+
+/**
+ * @brief Index of the piece containing seed x.
+ *
+ * @tparam Table A generated CompiledAlmanac.
+ */
+template <typename Table>
+constexpr size_t compiledPiece(long long x) {
+    return PieceSearch<Table::pieceCount>::find(Table::starts, 0, x);
+}
+
+/** @brief Location of seed x; same as applying every map in order. */
+template <typename Table>
+constexpr long long compiledLocation(long long x) {
+    return x + Table::deltas[compiledPiece<Table>(x)];
+}
+
+/** @brief Lowest location over the table's seeds (Part 1). */
+template <typename Table>
+constexpr long long compiledPart1() {
+
+    long long lowest = std::numeric_limits<long long>::max();
+    for (size_t i = 0; i < Table::seedCount; ++i) {
+        long long location = compiledLocation<Table>(Table::seeds[i]);
+        if (location < lowest) lowest = location;
+    }
+    return lowest;
+}
+
+/**
+ * @brief Lowest location over the table's seed ranges (Part 2).
+ *
+ * Every piece is increasing, so the lowest location of a range
+ * inside one piece is at its first seed: only the pieces the range
+ * overlaps are visited.
+ */
+template <typename Table>
+constexpr long long compiledPart2() {
+
+    long long lowest = std::numeric_limits<long long>::max();
+
+    for (size_t i = 0; i + 1 < Table::seedCount; i += 2) {
+
+        if (Table::seeds[i + 1] <= 0) continue;
+
+        long long first = Table::seeds[i];
+        long long last = first + Table::seeds[i + 1] - 1;
+
+        for (size_t p = compiledPiece<Table>(first); p < Table::pieceCount && Table::starts[p] <= last; ++p) {
+            long long from = Table::starts[p] > first ? Table::starts[p] : first;
+            long long location = from + Table::deltas[p];
+            if (location < lowest) lowest = location;
+        }
+    }
+    return lowest;
+}
+
+
+#endif // COMPILED_LOOKUP_H
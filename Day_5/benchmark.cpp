@@ -0,0 +1,254 @@
+#include "Almanac.h"
+#include "AlmanacBinary.h"
+#include "ThreadPool.h"
+
+#include <chrono>
+#include <thread>
+#include <limits>
+#include <algorithm>
+#include <random>
+#include <set>
+#include <cstdlib>
+#include <new>
+
+// counts every heap allocation made by the program
+static size_t heapAllocations = 0;
+
+void* operator new(std::size_t size) {
+    heapAllocations++;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    heapAllocations++;
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+using namespace std;
+
+// Times 'solve' over a number of runs and prints the average per run.
+template <typename Func>
+void timeSolution(const std::string& label, int runs, Func solve) {
+
+    long long answer = 0;
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; ++i)
+        answer = solve();
+    auto end = std::chrono::steady_clock::now();
+
+    double micros = std::chrono::duration<double, std::micro>(end - begin).count() / runs;
+
+    std::cout << label << ": " << answer << " (" << micros << " us/run)" << std::endl;
+}
+
+// Builds an almanac with 7 maps of 'rulesPerMap' disjoint rules
+// and 'seedRanges' seed ranges, all inside [0, 2^32).
+Almanac makeSyntheticAlmanac(int seedRanges, int rulesPerMap, unsigned seed) {
+
+    const long long domain = 1LL << 32;
+    std::mt19937_64 rng(seed);
+
+    Almanac a("synthetic");
+
+    for (int i = 0; i < seedRanges; ++i) {
+        long long length = 1 + (long long)(rng() % 20000000);
+        a.seeds.push_back((long long)(rng() % (domain - length)));
+        a.seeds.push_back(length);
+    }
+
+    for (int m = 0; m < 7; ++m) {
+
+        // distinct sorted cut points -> consecutive disjoint source intervals
+        std::set<long long> distinct;
+        while ((int)distinct.size() < 2 * rulesPerMap)
+            distinct.insert((long long)(rng() % domain));
+        std::vector<long long> cuts(distinct.begin(), distinct.end());
+
+        RuleMap map;
+        map.name = "synthetic-" + std::to_string(m) + " map:";
+
+        for (int r = 0; r < rulesPerMap; ++r) {
+            long long srcStart = cuts[2 * r];
+            long long length = cuts[2 * r + 1] - srcStart + 1;
+            long long destStart = (long long)(rng() % (domain - length));
+            map.rules.push_back({srcStart, srcStart + length - 1, destStart - srcStart});
+        }
+
+        map.buildIndex();
+        a.ruleMaps.push_back(map);
+    }
+
+    return a;
+}
+
+// random inserts, removals and changes of rules; after each one, the
+// incremental solutions that are asked for must match a full re-solve.
+// The first 'part2Only' updates only re-solve Part 2, so Part 1 has to
+// catch up on many pending changes. Returns the number of mismatches
+// (for Part 1, of every seed's cached location).
+int checkIncrementalUpdates(Almanac& a, int updates, int part2Only, unsigned seed) {
+
+    const long long domain = 1LL << 32;
+    std::mt19937_64 rng(seed);
+
+    for (RuleMap& map : a.ruleMaps)
+        map.buildIndex();
+    a.resetIncrementalCache();
+    a.getSolutionPart1Incremental();
+    a.getSolutionPart2Incremental();
+
+    // every cached location, not only the lowest one
+    auto checkPart1 = [](Almanac& a) {
+        int wrong = a.getSolutionPart1Incremental() != a.getSolutionPart1();
+        for (size_t i = 0; i < a.seeds.size(); ++i)
+            wrong += a.seedStages.back()[i] != a.applySingleSeed(a.seeds[i]);
+        return wrong;
+    };
+
+    int mismatches = 0;
+
+    for (int u = 0; u < updates; ++u) {
+
+        int mapIndex = (int)(rng() % a.ruleMaps.size());
+        int ruleCount = (int)a.ruleMaps[mapIndex].rules.size();
+
+        long long length = 1 + (long long)(rng() % 50000000);
+        long long srcStart = (long long)(rng() % (domain - length));
+        Rule rule = {srcStart, srcStart + length - 1, (long long)(rng() % domain) - srcStart};
+
+        int action = ruleCount == 0 ? 0 : (int)(rng() % 3);
+        if (action == 0) a.insertRule(mapIndex, (int)(rng() % (ruleCount + 1)), rule);
+        else if (action == 1) a.eraseRule(mapIndex, (int)(rng() % ruleCount));
+        else a.modifyRule(mapIndex, (int)(rng() % ruleCount), rule);
+
+        // 0: Part 1 only, 1: Part 2 only, 2: both, 3: neither (changes pile up)
+        int check = u < part2Only ? 1 : (int)(rng() % 4);
+
+        if (check == 0 || check == 2)
+            mismatches += checkPart1(a);
+        if (check == 1 || check == 2)
+            mismatches += a.getSolutionPart2Incremental() != a.getSolutionPart2();
+    }
+
+    mismatches += checkPart1(a);
+    mismatches += a.getSolutionPart2Incremental() != a.getSolutionPart2();
+
+    return mismatches;
+}
+
+int main() {
+
+    std::cout << "Aoc 2023 Day 5 - Benchmark" << std::endl;
+
+    Almanac a("input.txt");
+    try {
+        a.readPuzzleInput();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    const int runs = 200;
+
+    std::cout << "=== LOADING ===" << std::endl;
+    saveAlmanacBinary(a, "almanac.bin");
+    timeSolution("Text parse ", runs, [&]() {
+        Almanac text("input.txt");
+        text.readPuzzleInput();
+        return (long long)text.ruleMaps.size();
+    });
+    timeSolution("Binary load", runs, [&]() {
+        Almanac binary("almanac.bin");
+        loadAlmanacBinary(binary, "almanac.bin");
+        return (long long)binary.ruleMaps.size();
+    });
+
+    // many individual seeds spread over the input's value range
+    std::vector<long long> manySeeds(1 << 20);
+    std::mt19937_64 rng(2023);
+    for (long long& s : manySeeds)
+        s = (long long)(rng() % 4300000000ULL);
+
+    std::cout << "=== PART 1 (" << manySeeds.size() << " seeds) ===" << std::endl;
+    timeSolution("Scalar    ", 10, [&]() {
+        long long minimum = std::numeric_limits<long long>::max();
+        for (long long s : manySeeds)
+            minimum = std::min(minimum, a.applySingleSeed(s));
+        return minimum;
+    });
+    timeSolution("Batch     ", 10, [&]() { return a.minLocationBatch(manySeeds.data(), manySeeds.size()); });
+
+    std::cout << "=== PART 2 ===" << std::endl;
+    timeSolution("Forward   ", runs, [&]() { return a.getSolutionPart2(); });
+    timeSolution("Best-first", runs, [&]() { return a.getSolutionPart2BestFirst(); });
+    timeSolution("Inverse   ", runs, [&]() { return a.getSolutionPart2Inverse(); });
+
+    // steady state: the warm arena must not allocate
+    a.getSolutionPart2();
+    size_t allocationsBefore = heapAllocations;
+    a.getSolutionPart2();
+    std::cout << "Steady-state heap allocations: " << (heapAllocations - allocationsBefore)
+              << " (arena growths last run: " << a.intervalArena.lastRunGrowths
+              << ", total: " << a.intervalArena.growths
+              << ", runs: " << a.intervalArena.runs << ")" << std::endl;
+
+    // thread scaling on a large synthetic almanac
+    Almanac large = makeSyntheticAlmanac(4000, 200, 5);
+
+    std::cout << "=== PART 2 (synthetic: 4000 ranges, 7 x 200 rules) ===" << std::endl;
+    timeSolution("Forward     ", 3, [&]() { return large.getSolutionPart2(); });
+    timeSolution("Best-first  ", 3, [&]() { return large.getSolutionPart2BestFirst(); });
+
+    // one pool per size, started outside the timed runs (the caller works too)
+    int maxThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    for (int workers = 1; workers <= maxThreads; workers *= 2) {
+        ThreadPool pool(workers);
+        timeSolution("Workers = " + std::to_string(workers), 3,
+                     [&]() { return large.getSolutionPart2Parallel(pool); });
+    }
+
+    // incremental updates: change one rule of the last map, re-solve
+    std::cout << "=== RULE UPDATES (synthetic, last map, Part 1 + Part 2) ===" << std::endl;
+    for (RuleMap& map : large.ruleMaps)
+        map.buildIndex();
+    large.getSolutionPart1Incremental();
+    large.getSolutionPart2Incremental();
+
+    int update = 0;
+    auto nudgeRule = [&]() {
+        int mapIndex = (int)large.ruleMaps.size() - 1;
+        int position = update++ % (int)large.ruleMaps[mapIndex].rules.size();
+        Rule r = large.ruleMaps[mapIndex].rules[position];
+        r.delta += 1;
+        large.modifyRule(mapIndex, position, r);
+    };
+
+    timeSolution("Full        ", 3, [&]() { nudgeRule(); return large.getSolutionPart1() + large.getSolutionPart2(); });
+    timeSolution("Incremental ", 3, [&]() {
+        nudgeRule();
+        return large.getSolutionPart1Incremental() + large.getSolutionPart2Incremental();
+    });
+
+    Almanac checked = makeSyntheticAlmanac(200, 30, 11);
+    int mismatches = checkIncrementalUpdates(checked, 2000, 1000, 17);
+    std::cout << "Incremental vs full after 2000 random updates: "
+              << (mismatches == 0 ? "match" : std::to_string(mismatches) + " MISMATCHES") << std::endl;
+
+    return mismatches == 0 ? 0 : 1;
+}
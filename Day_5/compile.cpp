@@ -0,0 +1,50 @@
+#include "Almanac.h"
+#include "AlmanacCodegen.h"
+
+#include <algorithm>
+
+using namespace std;
+
+// Compiles a text almanac into a C++ header of constexpr tables:
+//
+//     compile [input.txt] [CompiledAlmanac.h]
+//
+int main(int argc, char* argv[]) {
+
+    std::string textPath = argc > 1 ? argv[1] : "input.txt";
+    std::string headerPath = argc > 2 ? argv[2] : "CompiledAlmanac.h";
+
+    Almanac text(textPath);
+    try {
+        text.readPuzzleInput();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (text.seeds.empty() && text.ruleMaps.empty()) {
+        std::cerr << "No almanac in " << textPath << std::endl;
+        return 1;
+    }
+
+    // the composed pieces must agree with the maps on every seed
+    std::vector<AlmanacPiece> pieces = composeRuleMaps(text);
+
+    for (long long seed : text.seeds) {
+        auto after = std::upper_bound(pieces.begin(), pieces.end(), seed,
+                                      [](long long x, const AlmanacPiece& p) { return x < p.start; });
+        if (seed + (after - 1)->delta != text.applySingleSeed(seed)) {
+            std::cerr << "Composition mismatch for seed " << seed << std::endl;
+            return 1;
+        }
+    }
+
+    if (!saveAlmanacHeader(text, headerPath, textPath))
+        return 1;
+
+    std::cout << "Wrote " << headerPath << ": " << text.ruleMaps.size() << " maps, "
+              << pieces.size() << " pieces" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include "Almanac.h"
+#include "CompiledAlmanac.h"
+#include "CompiledLookup.h"
+
+#include <chrono>
+#include <limits>
+#include <algorithm>
+#include <random>
+
+using namespace std;
+
+// both answers are evaluated by the compiler
+static constexpr long long compiledSolution1 = compiledPart1<CompiledAlmanac>();
+static constexpr long long compiledSolution2 = compiledPart2<CompiledAlmanac>();
+
+// Times 'solve' over a number of runs and prints the average per run.
+template <typename Func>
+void timeSolution(const std::string& label, int runs, Func solve) {
+
+    long long answer = 0;
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; ++i)
+        answer = solve();
+    auto end = std::chrono::steady_clock::now();
+
+    double micros = std::chrono::duration<double, std::micro>(end - begin).count() / runs;
+
+    std::cout << label << ": " << answer << " (" << micros << " us/run)" << std::endl;
+}
+
+// Rebuilds the runtime almanac from the rules kept in the header (no parsing).
+Almanac runtimeAlmanac() {
+
+    Almanac a(CompiledAlmanac::source);
+    a.seeds.assign(CompiledAlmanac::seeds, CompiledAlmanac::seeds + CompiledAlmanac::seedCount);
+
+    for (size_t m = 0; m < CompiledAlmanac::mapCount; ++m) {
+
+        RuleMap map;
+        map.name = CompiledAlmanac::mapNames[m];
+
+        for (size_t r = CompiledAlmanac::ruleOffsets[m]; r < CompiledAlmanac::ruleOffsets[m + 1]; ++r) {
+            const long long* rule = CompiledAlmanac::rules[r];
+            map.rules.push_back({rule[0], rule[1], rule[2]});
+        }
+
+        map.buildIndex();
+        a.ruleMaps.push_back(map);
+    }
+
+    return a;
+}
+
+// Compares the compiled almanac with RuleMap::apply (run from any directory).
+int main() {
+
+    std::cout << "Aoc 2023 Day 5 - Compiled almanac (" << CompiledAlmanac::source << ", "
+              << CompiledAlmanac::pieceCount << " pieces)" << std::endl;
+
+    Almanac a = runtimeAlmanac();
+
+    std::cout << "=== ANSWERS ===" << std::endl;
+    std::cout << "Solution Part 1 (compile time) = " << compiledSolution1 << std::endl;
+    std::cout << "Solution Part 2 (compile time) = " << compiledSolution2 << std::endl;
+
+    if (a.getSolutionPart1() != compiledSolution1 || a.getSolutionPart2() != compiledSolution2) {
+        std::cerr << "Compiled answers differ from RuleMap::apply" << std::endl;
+        return 1;
+    }
+
+    // many individual seeds spread over the input's value range
+    std::vector<long long> manySeeds(1 << 20);
+    std::mt19937_64 rng(2023);
+    for (long long& s : manySeeds)
+        s = (long long)(rng() % 4300000000ULL);
+
+    for (long long s : manySeeds) {
+        if (compiledLocation<CompiledAlmanac>(s) != a.applySingleSeed(s)) {
+            std::cerr << "Compiled lookup differs from RuleMap::apply for seed " << s << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "=== PART 1 (" << manySeeds.size() << " seeds) ===" << std::endl;
+    timeSolution("RuleMap::apply", 10, [&]() {
+        long long minimum = std::numeric_limits<long long>::max();
+        for (long long s : manySeeds)
+            minimum = std::min(minimum, a.applySingleSeed(s));
+        return minimum;
+    });
+    timeSolution("Batch         ", 10, [&]() { return a.minLocationBatch(manySeeds.data(), manySeeds.size()); });
+    timeSolution("Compiled      ", 10, [&]() {
+        long long minimum = std::numeric_limits<long long>::max();
+        for (long long s : manySeeds)
+            minimum = std::min(minimum, compiledLocation<CompiledAlmanac>(s));
+        return minimum;
+    });
+
+    return 0;
+}
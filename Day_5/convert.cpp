@@ -0,0 +1,44 @@
+#include "Almanac.h"
+#include "AlmanacBinary.h"
+
+using namespace std;
+
+// Converts a text almanac into the binary format:
+//
+//     convert [input.txt] [almanac.bin]
+//
+int main(int argc, char* argv[]) {
+
+    std::string textPath = argc > 1 ? argv[1] : "input.txt";
+    std::string binaryPath = argc > 2 ? argv[2] : "almanac.bin";
+
+    Almanac text(textPath);
+    try {
+        text.readPuzzleInput();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (!saveAlmanacBinary(text, binaryPath))
+        return 1;
+
+    // round trip: the binary almanac must give the same answers
+    Almanac binary(binaryPath);
+    if (!loadAlmanacBinary(binary, binaryPath))
+        return 1;
+
+    long long expected1 = text.getSolutionPart1();
+    long long expected2 = text.getSolutionPart2();
+
+    if (binary.getSolutionPart1() != expected1 || binary.getSolutionPart2() != expected2) {
+        std::cerr << "Round trip mismatch for " << binaryPath << std::endl;
+        return 1;
+    }
+
+    std::cout << "Wrote " << binaryPath << ": " << text.seeds.size() << " seeds, "
+              << text.ruleMaps.size() << " maps" << std::endl;
+
+    return 0;
+}
@@ -1,22 +1,38 @@
-#include "Almanac.cpp"
-
-using namespace std;
-
-int main() {
-
-    std::cout << "Aoc 2023 Day 5" << std::endl;
-
-    // Part 1
-    std::cout << "=== PART 1 ===" << std::endl;
-    Almanac a("input.txt");
-    a.readPuzzleInput();
-    long long solution1 = a.getSolutionPart1();
-    std::cout << "Solution Part 1 = " << solution1 << std::endl;
-
-    std::cout << "=== PART 1 ===" << std::endl;
-    long long solution2 = a.getSolutionPart2();
-    std::cout << "Solution Part 2 = " << solution2 << std::endl;
-
-    return 0;
-
-}
+#include "Almanac.h"
+
+using namespace std;
+
+int main() {
+
+    std::cout << "Aoc 2023 Day 5" << std::endl;
+
+    // Part 1
+    std::cout << "=== PART 1 ===" << std::endl;
+    Almanac a("input.txt");
+    try {
+        a.readPuzzleInput();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "error: " << e.what() << std::endl;
+        return 1;
+    }
+    long long solution1 = a.getSolutionPart1();
+    std::cout << "Solution Part 1 = " << solution1 << std::endl;
+
+    std::cout << "=== PART 1 ===" << std::endl;
+    long long solution2 = a.getSolutionPart2();
+    std::cout << "Solution Part 2 = " << solution2 << std::endl;
+
+    long long solution2BestFirst = a.getSolutionPart2BestFirst();
+    std::cout << "Solution Part 2 (best-first) = " << solution2BestFirst << std::endl;
+
+    long long solution2Inverse = a.getSolutionPart2Inverse();
+    std::cout << "Solution Part 2 (inverse) = " << solution2Inverse << std::endl;
+
+    std::cout << "Lowest locations:" << std::endl;
+    for (const LocationHit& hit : a.getLowestLocations(5))
+        std::cout << "  location " << hit.location << " <- seed " << hit.seed << std::endl;
+
+    return 0;
+
+}
@@ -0,0 +1,25 @@
+#include "InputGenerators.h"
+
+#include <iostream>
+
+// Day 1 calibration document generator, writes to stdout:
+//
+//     generate_day1 [lines=1000] [length=40] [spelled=0.1] [digits=0.05] [seed=1]
+//
+int main(int argc, char* argv[]) {
+
+    GeneratorArgs args(argc, argv);
+
+    CalibrationParams params;
+    params.lines = args.get("lines", params.lines);
+    params.lineLength = (int)args.get("length", (int64_t)params.lineLength);
+    params.spelledDensity = args.get("spelled", params.spelledDensity);
+    params.digitDensity = args.get("digits", params.digitDensity);
+    params.seed = (uint64_t)args.get("seed", (int64_t)params.seed);
+
+    if (!args.allUsed("generate_day1 [lines=1000] [length=40] [spelled=0.1] [digits=0.05] [seed=1]"))
+        return 1;
+
+    generateCalibration(std::cout, params);
+    return 0;
+}
@@ -0,0 +1,25 @@
+#include "InputGenerators.h"
+
+#include <iostream>
+
+// Day 2 game log generator, writes to stdout:
+//
+//     generate_day2 [games=100] [draws=5] [max=20] [colors=3] [seed=1]
+//
+int main(int argc, char* argv[]) {
+
+    GeneratorArgs args(argc, argv);
+
+    GameParams params;
+    params.games = args.get("games", params.games);
+    params.draws = (int)args.get("draws", (int64_t)params.draws);
+    params.maxCount = (int)args.get("max", (int64_t)params.maxCount);
+    params.colors = (int)args.get("colors", (int64_t)params.colors);
+    params.seed = (uint64_t)args.get("seed", (int64_t)params.seed);
+
+    if (!args.allUsed("generate_day2 [games=100] [draws=5] [max=20] [colors=3] [seed=1]"))
+        return 1;
+
+    generateGames(std::cout, params);
+    return 0;
+}
@@ -0,0 +1,25 @@
+#include "InputGenerators.h"
+
+#include <iostream>
+
+// Day 3 engine schematic generator, writes to stdout:
+//
+//     generate_day3 [rows=140] [cols=140] [numbers=0.08] [symbols=0.05] [seed=1]
+//
+int main(int argc, char* argv[]) {
+
+    GeneratorArgs args(argc, argv);
+
+    SchematicParams params;
+    params.rows = (int)args.get("rows", (int64_t)params.rows);
+    params.cols = (int)args.get("cols", (int64_t)params.cols);
+    params.numberDensity = args.get("numbers", params.numberDensity);
+    params.symbolDensity = args.get("symbols", params.symbolDensity);
+    params.seed = (uint64_t)args.get("seed", (int64_t)params.seed);
+
+    if (!args.allUsed("generate_day3 [rows=140] [cols=140] [numbers=0.08] [symbols=0.05] [seed=1]"))
+        return 1;
+
+    generateSchematic(std::cout, params);
+    return 0;
+}
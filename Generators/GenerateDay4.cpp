@@ -0,0 +1,28 @@
+#include "InputGenerators.h"
+
+#include <iostream>
+
+// Day 4 scratchcards generator, writes to stdout:
+//
+//     generate_day4 [cards=200] [winning=10] [numbers=25] [max=99] [matches=10] [chance=0.15] [block=200] [seed=1]
+//
+int main(int argc, char* argv[]) {
+
+    GeneratorArgs args(argc, argv);
+
+    CardParams params;
+    params.cards = args.get("cards", params.cards);
+    params.winning = (int)args.get("winning", (int64_t)params.winning);
+    params.numbers = (int)args.get("numbers", (int64_t)params.numbers);
+    params.maxValue = (int)args.get("max", (int64_t)params.maxValue);
+    params.maxMatches = (int)args.get("matches", (int64_t)params.maxMatches);
+    params.matchChance = args.get("chance", params.matchChance);
+    params.blockSize = (int)args.get("block", (int64_t)params.blockSize);
+    params.seed = (uint64_t)args.get("seed", (int64_t)params.seed);
+
+    if (!args.allUsed("generate_day4 [cards=200] [winning=10] [numbers=25] [max=99] [matches=10] [chance=0.15] [block=200] [seed=1]"))
+        return 1;
+
+    generateCards(std::cout, params);
+    return 0;
+}
@@ -0,0 +1,24 @@
+#include "InputGenerators.h"
+
+#include <iostream>
+
+// Day 5 almanac generator, writes to stdout:
+//
+//     generate_day5 [ranges=10] [rules=30] [length=500000000] [seed=1]
+//
+int main(int argc, char* argv[]) {
+
+    GeneratorArgs args(argc, argv);
+
+    AlmanacParams params;
+    params.seedRanges = (int)args.get("ranges", (int64_t)params.seedRanges);
+    params.rulesPerMap = (int)args.get("rules", (int64_t)params.rulesPerMap);
+    params.maxRangeLength = args.get("length", params.maxRangeLength);
+    params.seed = (uint64_t)args.get("seed", (int64_t)params.seed);
+
+    if (!args.allUsed("generate_day5 [ranges=10] [rules=30] [length=500000000] [seed=1]"))
+        return 1;
+
+    generateAlmanac(std::cout, params);
+    return 0;
+}
@@ -0,0 +1,275 @@
+#include "InputGenerators.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <set>
+#include <vector>
+
+typedef std::mt19937_64 Rng;
+
+// uniform integer in [0, n)
+static uint64_t below(Rng& rng, uint64_t n) {
+    return n == 0 ? 0 : rng() % n;
+}
+
+// true with probability p
+static bool chance(Rng& rng, double p) {
+    return (double)(rng() >> 11) * (1.0 / 9007199254740992.0) < p;
+}
+
+// 'count' distinct values in [1, maxValue], none of them in 'excluded'
+static std::vector<int> drawDistinct(Rng& rng, int count, int maxValue, const std::set<int>& excluded) {
+
+    std::set<int> taken(excluded);
+    std::vector<int> values;
+
+    while ((int)values.size() < count) {
+        int v = 1 + (int)below(rng, (uint64_t)maxValue);
+        if (taken.insert(v).second)
+            values.push_back(v);
+    }
+
+    return values;
+}
+
+// Fisher-Yates with the portable 'below'
+template <typename T>
+static void shuffle(Rng& rng, std::vector<T>& items) {
+    for (size_t i = items.size(); i > 1; --i)
+        std::swap(items[i - 1], items[below(rng, i)]);
+}
+
+
+void generateCalibration(std::ostream& out, const CalibrationParams& params) {
+
+    static const char* words[9] = { "one", "two", "three", "four", "five", "six", "seven", "eight", "nine" };
+
+    Rng rng(params.seed);
+
+    for (int64_t i = 0; i < params.lines; ++i) {
+
+        std::string line;
+        bool hasDigit = false;
+
+        while ((int)line.size() < params.lineLength) {
+
+            if (chance(rng, params.spelledDensity)) {
+                line += words[below(rng, 9)];
+            }
+            else if (chance(rng, params.digitDensity)) {
+                line += (char)('1' + below(rng, 9));
+                hasDigit = true;
+            }
+            else {
+                line += (char)('a' + below(rng, 26));
+            }
+        }
+
+        // Part 1 needs at least one numeric digit per line
+        if (!hasDigit)
+            line[below(rng, line.size())] = (char)('1' + below(rng, 9));
+
+        out << line << '\n';
+    }
+}
+
+void generateGames(std::ostream& out, const GameParams& params) {
+
+    static const char* colors[16] = {
+        "red", "green", "blue", "yellow", "orange", "purple", "black", "white",
+        "cyan", "magenta", "brown", "pink", "gray", "olive", "navy", "teal"
+    };
+
+    int colorCount = std::max(1, std::min(params.colors, 16));
+
+    Rng rng(params.seed);
+
+    for (int64_t id = 1; id <= params.games; ++id) {
+
+        out << "Game " << id << ":";
+
+        for (int d = 0; d < params.draws; ++d) {
+
+            // non-empty subset of the colors, in random order
+            std::vector<int> order(colorCount);
+            for (int c = 0; c < colorCount; ++c) order[c] = c;
+            shuffle(rng, order);
+            int shown = 1 + (int)below(rng, (uint64_t)colorCount);
+
+            for (int c = 0; c < shown; ++c) {
+                out << (c == 0 ? " " : ", ")
+                    << 1 + below(rng, (uint64_t)params.maxCount) << " " << colors[order[c]];
+            }
+
+            if (d + 1 < params.draws) out << ";";
+        }
+
+        out << '\n';
+    }
+}
+
+void generateSchematic(std::ostream& out, const SchematicParams& params) {
+
+    static const std::string symbolChars = "*#+$/@%&=-";
+
+    Rng rng(params.seed);
+    std::string row;
+
+    for (int r = 0; r < params.rows; ++r) {
+
+        row.clear();
+
+        while ((int)row.size() < params.cols) {
+
+            int room = params.cols - (int)row.size();
+
+            if (chance(rng, params.numberDensity)) {
+
+                int digits = std::min(room, 1 + (int)below(rng, 3));
+                row += (char)('1' + below(rng, 9));
+                for (int d = 1; d < digits; ++d)
+                    row += (char)('0' + below(rng, 10));
+
+                // separate from the next number
+                if ((int)row.size() < params.cols)
+                    row += chance(rng, params.symbolDensity) ? symbolChars[below(rng, symbolChars.size())] : '.';
+            }
+            else if (chance(rng, params.symbolDensity)) {
+                row += symbolChars[below(rng, symbolChars.size())];
+            }
+            else {
+                row += '.';
+            }
+        }
+
+        out << row << '\n';
+    }
+}
+
+void generateCards(std::ostream& out, const CardParams& params) {
+
+    Rng rng(params.seed);
+
+    int maxMatches = std::min(params.maxMatches, std::min(params.winning, params.numbers));
+
+    // enough distinct values for both lists
+    int maxValue = std::max(params.maxValue, params.winning + params.numbers);
+
+    for (int64_t id = 1; id <= params.cards; ++id) {
+
+        // cards close to the end of a block never reach the next block
+        int64_t inBlock = (id - 1) % params.blockSize;
+        int matches = 0;
+        if (inBlock < params.blockSize - maxMatches && maxMatches > 0 && chance(rng, params.matchChance))
+            matches = 1 + (int)below(rng, (uint64_t)maxMatches);
+
+        std::vector<int> winning = drawDistinct(rng, params.winning, maxValue, {});
+
+        // 'matches' winning numbers, then numbers outside the winning set
+        std::vector<int> numbers(winning.begin(), winning.begin() + matches);
+        std::vector<int> others = drawDistinct(rng, params.numbers - matches, maxValue,
+                                               std::set<int>(winning.begin(), winning.end()));
+        numbers.insert(numbers.end(), others.begin(), others.end());
+        shuffle(rng, numbers);
+
+        out << "Card " << std::setw(3) << id << ":";
+        for (int w : winning) out << " " << std::setw(2) << w;
+        out << " |";
+        for (int n : numbers) out << " " << std::setw(2) << n;
+        out << '\n';
+    }
+}
+
+void generateAlmanac(std::ostream& out, const AlmanacParams& params) {
+
+    static const char* mapNames[7] = {
+        "seed-to-soil", "soil-to-fertilizer", "fertilizer-to-water", "water-to-light",
+        "light-to-temperature", "temperature-to-humidity", "humidity-to-location"
+    };
+
+    const uint64_t domain = 1ULL << 32;
+    Rng rng(params.seed);
+
+    out << "seeds:";
+    for (int i = 0; i < params.seedRanges; ++i) {
+        uint64_t length = 1 + below(rng, (uint64_t)params.maxRangeLength);
+        out << " " << below(rng, domain - length) << " " << length;
+    }
+    out << "\n";
+
+    for (const char* name : mapNames) {
+
+        // distinct sorted cut points -> consecutive disjoint source intervals
+        // (a repeated cut would make one rule end where the next starts)
+        std::set<uint64_t> distinct;
+        while (distinct.size() < 2 * (size_t)params.rulesPerMap)
+            distinct.insert(below(rng, domain));
+        std::vector<uint64_t> cuts(distinct.begin(), distinct.end());
+
+        std::vector<std::string> lines;
+        for (int r = 0; r < params.rulesPerMap; ++r) {
+            uint64_t srcStart = cuts[2 * r];
+            uint64_t length = cuts[2 * r + 1] - srcStart + 1;
+            uint64_t destStart = below(rng, domain - length);
+            lines.push_back(std::to_string(destStart) + " " + std::to_string(srcStart) + " " + std::to_string(length));
+        }
+
+        // rules are listed in no particular order
+        shuffle(rng, lines);
+
+        out << "\n" << name << " map:\n";
+        for (const std::string& line : lines)
+            out << line << "\n";
+    }
+}
+
+
+GeneratorArgs::GeneratorArgs(int argc, char* argv[]) {
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        size_t eq = arg.find('=');
+        if (eq == std::string::npos) {
+            values[arg] = "";
+            used[arg] = false;
+            continue;
+        }
+        values[arg.substr(0, eq)] = arg.substr(eq + 1);
+        used[arg.substr(0, eq)] = false;
+    }
+}
+
+int64_t GeneratorArgs::get(const std::string& key, int64_t fallback) {
+
+    auto it = values.find(key);
+    if (it == values.end()) return fallback;
+
+    used[key] = true;
+    return std::stoll(it->second);
+}
+
+double GeneratorArgs::get(const std::string& key, double fallback) {
+
+    auto it = values.find(key);
+    if (it == values.end()) return fallback;
+
+    used[key] = true;
+    return std::stod(it->second);
+}
+
+bool GeneratorArgs::allUsed(const std::string& usage) const {
+
+    bool ok = true;
+
+    for (const auto& entry : used) {
+        if (!entry.second) {
+            std::cerr << "Unknown argument: " << entry.first << "\n";
+            ok = false;
+        }
+    }
+
+    if (!ok) std::cerr << "Usage: " << usage << std::endl;
+    return ok;
+}
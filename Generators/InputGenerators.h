@@ -0,0 +1,155 @@
+#ifndef INPUT_GENERATORS_H
+#define INPUT_GENERATORS_H
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+
+// Synthetic puzzle inputs for scaling tests and benchmarks.
+
+/*
+    === DETERMINISM ===
+
+Every generator draws from its own std::mt19937_64 seeded with 'seed'.
+Values are taken as raw engine output reduced with '%', never through
+std::*_distribution (whose algorithms differ between standard libraries).
+The same parameters therefore produce the same bytes on every platform.
+*/
+
+
+/**
+ * @struct CalibrationParams
+ * @brief Day 1: calibration document shape.
+ *
+ * Each line is a mix of filler letters, numeric digits and spelled
+ * digits ("one" .. "nine"). Every line contains at least one numeric
+ * digit, as required by Part 1.
+ */
+
+struct CalibrationParams {
+    int64_t lines = 1000;
+    int lineLength = 40;        // approximate characters per line
+    double spelledDensity = 0.1; // chance a token is a spelled digit
+    double digitDensity = 0.05;  // chance a token is a numeric digit
+    uint64_t seed = 1;
+};
+
+/**
+ * @struct GameParams
+ * @brief Day 2: game log shape.
+ */
+
+struct GameParams {
+    int64_t games = 100;
+    int draws = 5;      // cube sets per game
+    int maxCount = 20;  // largest count of one color in a draw
+    int colors = 3;     // red, green, blue, then further colors (up to 16)
+    uint64_t seed = 1;
+};
+
+/**
+ * @struct SchematicParams
+ * @brief Day 3: engine schematic shape.
+ *
+ * Cells are filled left to right: a number (1-3 digits) starts with
+ * probability numberDensity, a symbol with symbolDensity, otherwise '.'.
+ * Numbers are always followed by a non-digit cell.
+ */
+
+struct SchematicParams {
+    int rows = 140;
+    int cols = 140;
+    double numberDensity = 0.08;
+    double symbolDensity = 0.05;
+    uint64_t seed = 1;
+};
+
+/**
+ * @struct CardParams
+ * @brief Day 4: scratchcard shape.
+ *
+ * Each card has 'winning' winning numbers and 'numbers' played numbers,
+ * all distinct within their list and drawn from [1, maxValue].
+ *
+ * A card has matches with probability matchChance, then between 1 and
+ * maxMatches of them. The last maxMatches cards of every block of
+ * blockSize cards have no matches, so copies never cross block
+ * boundaries. Keep matchChance * (maxMatches + 1) / 2 below 1, or the
+ * Part 2 copy counts grow exponentially within a block.
+ */
+
+struct CardParams {
+    int64_t cards = 200;
+    int winning = 10;
+    int numbers = 25;
+    int maxValue = 99;
+    int maxMatches = 10;
+    double matchChance = 0.15;
+    int blockSize = 200;
+    uint64_t seed = 1;
+};
+
+/**
+ * @struct AlmanacParams
+ * @brief Day 5: almanac shape.
+ *
+ * Seven maps (seed-to-soil ... humidity-to-location), each with
+ * rulesPerMap disjoint rules inside [0, 2^32), and seedRanges seed
+ * ranges of up to maxRangeLength seeds.
+ */
+
+struct AlmanacParams {
+    int seedRanges = 10;
+    int rulesPerMap = 30;
+    int64_t maxRangeLength = 500000000;
+    uint64_t seed = 1;
+};
+
+
+/** @brief Writes a Day 1 calibration document. */
+void generateCalibration(std::ostream& out, const CalibrationParams& params);
+
+/** @brief Writes a Day 2 game log ("Game N: 3 red, 4 blue; ..."). */
+void generateGames(std::ostream& out, const GameParams& params);
+
+/** @brief Writes a Day 3 engine schematic of rows x cols cells. */
+void generateSchematic(std::ostream& out, const SchematicParams& params);
+
+/** @brief Writes Day 4 scratchcards ("Card N: winning | numbers"). */
+void generateCards(std::ostream& out, const CardParams& params);
+
+/** @brief Writes a Day 5 almanac (seeds line and seven maps). */
+void generateAlmanac(std::ostream& out, const AlmanacParams& params);
+
+
+/**
+ * @class GeneratorArgs
+ * @brief Parses "key=value" command line arguments of the generator tools.
+ *
+ * Unknown keys are reported; get() returns the fallback when a key is absent.
+ */
+
+class GeneratorArgs {
+
+public:
+
+    GeneratorArgs(int argc, char* argv[]);
+
+    int64_t get(const std::string& key, int64_t fallback);
+    double get(const std::string& key, double fallback);
+
+    /**
+     * @brief Prints keys that were given but never read.
+     * @return True if every given key was used.
+     */
+    bool allUsed(const std::string& usage) const;
+
+private:
+
+    std::map<std::string, std::string> values;
+    std::map<std::string, bool> used;
+};
+
+
+#endif // INPUT_GENERATORS_H
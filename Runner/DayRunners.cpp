@@ -0,0 +1,105 @@
+#include "DayRunners.h"
+#include "ThreadPool.h"
+
+#include "WeatherCalibrationSolver.h"
+#include "CubeConundrumSolver.h"
+#include "GearRatiosSolver.h"
+#include "ScratchcardSolver.h"
+#include "AlmanacSolver.h"
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <sys/resource.h>
+
+// milliseconds spent in f()
+template <typename F>
+static double timeMs(F&& f) {
+
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// times solve() and stores its answer, or the error it threw
+template <typename F>
+static void solvePart(std::string& answer, double& ms, F&& solve) {
+
+    try {
+        ms = timeMs([&] { answer = std::to_string(solve()); });
+    }
+    catch (const std::exception& e) {
+        answer = std::string("error: ") + e.what();
+    }
+}
+
+// parse task: builds the shared model, then queues one task per part
+template <typename S>
+static void scheduleSolver(ThreadPool& pool, RunResult& result) {
+
+    S solver;
+    std::shared_ptr<const typename S::Model> model;
+
+    result.parseMs = timeMs([&] { model = solver.parse(result.request.path); });
+    result.peakRssKb = peakRssKb();
+
+    if (result.request.part1)
+        pool.submit([&result, solver, model] {
+            solvePart(result.part1, result.part1Ms, [&] { return solver.part1(*model); });
+        });
+
+    if (result.request.part2)
+        pool.submit([&result, solver, model] {
+            solvePart(result.part2, result.part2Ms, [&] { return solver.part2(*model); });
+        });
+}
+
+
+bool isKnownDay(int day) {
+    return day >= 1 && day <= 5;
+}
+
+std::string defaultInputPath(int day) {
+    return "Day_" + std::to_string(day) + "/input.txt";
+}
+
+void scheduleDay(ThreadPool& pool, const RunRequest& request, RunResult& result) {
+
+    result.request = request;
+
+    pool.submit([&pool, &result] {
+
+        try {
+
+            switch (result.request.day) {
+                case 1: scheduleSolver<WeatherCalibrationSolver>(pool, result); break;
+                case 2: scheduleSolver<CubeConundrumSolver>(pool, result); break;
+                case 3: scheduleSolver<GearRatiosSolver>(pool, result); break;
+                case 4: scheduleSolver<ScratchcardSolver>(pool, result); break;
+                case 5: scheduleSolver<AlmanacSolver>(pool, result); break;
+                default:
+                    throw std::runtime_error("no solver for day " + std::to_string(result.request.day));
+            }
+        }
+        catch (const std::exception& e) {
+            result.parseMs = -1;
+            result.error = e.what();
+        }
+    });
+}
+
+long peakRssKb() {
+
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+
+    // Linux reports KiB, macOS bytes
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+}
@@ -0,0 +1,76 @@
+#ifndef DAY_RUNNERS_H
+#define DAY_RUNNERS_H
+
+#include <string>
+
+class ThreadPool;
+
+
+/**
+ * @struct RunRequest
+ * @brief One solver run: a day, its input file and the parts to solve.
+ */
+
+struct RunRequest {
+    int day = 0;
+    std::string path;
+    bool part1 = true;
+    bool part2 = true;
+};
+
+/**
+ * @struct RunResult
+ * @brief Answers and wall-clock times of one solver run.
+ *
+ * Times are in milliseconds, negative for a phase that did not run.
+ * peakRssKb is the process-wide peak resident set size sampled after
+ * parsing; with concurrent runs it includes the other runs' memory.
+ * A part that failed holds "error: ..." instead of its answer.
+ */
+
+struct RunResult {
+    RunRequest request;
+    std::string part1;
+    std::string part2;
+    double parseMs = -1;
+    double part1Ms = -1;
+    double part2Ms = -1;
+    long peakRssKb = 0;
+    std::string error;
+};
+
+
+/**
+ * @brief Returns true if runDay() has a solver for the given day.
+ */
+bool isKnownDay(int day);
+
+/**
+ * @brief Default input of a day, relative to the repository root.
+ *
+ * @return "Day_<day>/input.txt".
+ */
+std::string defaultInputPath(int day);
+
+/**
+ * @brief Queues a solver run on the pool, timing each phase.
+ *
+ * One task parses the input into the day's immutable Solver model
+ * (for Day 3 this includes extracting numbers and symbols); it then
+ * queues Part 1 and Part 2 as separate tasks sharing that model.
+ * Errors (unknown day, missing file, exceptions) are reported in
+ * RunResult::error.
+ *
+ * @param pool Pool running the tasks.
+ * @param request What to run.
+ * @param result Receives answers and timings; must stay alive until pool.wait().
+ */
+void scheduleDay(ThreadPool& pool, const RunRequest& request, RunResult& result);
+
+/**
+ * @brief Peak resident set size of the process so far, in KiB.
+ */
+long peakRssKb();
+
+
+#endif // DAY_RUNNERS_H
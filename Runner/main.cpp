@@ -0,0 +1,177 @@
+#include "DayRunners.h"
+#include "Instrumentation.h"
+#include "ThreadPool.h"
+
+#include <chrono>
+#include <cctype>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Runs any subset of days and parts concurrently and prints a timing table:
+//
+//     aoc_runner [--threads=N] [--parts=1|2|12] [--metrics=FILE] [--verbose] [day[:path]]...
+//
+// Without day arguments every day runs on Day_<day>/input.txt (run it from
+// the repository root). A day can be given several times with different
+// inputs. Each run parses on one task and then solves its parts as
+// separate tasks sharing the parsed model, all on one shared pool.
+// --metrics writes the instrumentation counters and phase timers (JSON
+// for *.json, Prometheus text otherwise); build with AOC_INSTRUMENT=ON.
+
+// discards the solvers' progress messages while runs are in flight
+struct NullBuffer : std::streambuf {
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+static void printUsage() {
+    std::cerr << "usage: aoc_runner [--threads=N] [--parts=1|2|12] [--metrics=FILE] [--verbose] [day[:path]]..." << std::endl;
+}
+
+static std::string formatMs(double ms) {
+
+    if (ms < 0) return "-";
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(3) << ms;
+    return out.str();
+}
+
+int main(int argc, char* argv[]) {
+
+    int threadCount = 0;
+    bool part1 = true;
+    bool part2 = true;
+    bool verbose = false;
+    std::string metricsPath;
+    std::vector<RunRequest> requests;
+
+    for (int i = 1; i < argc; ++i) {
+
+        std::string arg = argv[i];
+
+        if (arg.rfind("--threads=", 0) == 0) {
+            threadCount = std::atoi(arg.c_str() + 10);
+        }
+        else if (arg.rfind("--parts=", 0) == 0) {
+            std::string parts = arg.substr(8);
+            part1 = parts.find('1') != std::string::npos;
+            part2 = parts.find('2') != std::string::npos;
+        }
+        else if (arg.rfind("--metrics=", 0) == 0) {
+            metricsPath = arg.substr(10);
+        }
+        else if (arg == "--verbose") {
+            verbose = true;
+        }
+        else if (!arg.empty() && std::isdigit((unsigned char)arg[0])) {
+            RunRequest r;
+            size_t colon = arg.find(':');
+            r.day = std::atoi(arg.substr(0, colon).c_str());
+            r.path = (colon == std::string::npos) ? defaultInputPath(r.day) : arg.substr(colon + 1);
+            requests.push_back(r);
+        }
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (requests.empty()) {
+        for (int day = 1; isKnownDay(day); ++day) {
+            RunRequest r;
+            r.day = day;
+            r.path = defaultInputPath(day);
+            requests.push_back(r);
+        }
+    }
+
+    for (RunRequest& r : requests) {
+        r.part1 = part1;
+        r.part2 = part2;
+    }
+
+    std::vector<RunResult> results(requests.size());
+
+    NullBuffer sink;
+    std::streambuf* previous = verbose ? nullptr : std::cout.rdbuf(&sink);
+
+    auto start = std::chrono::steady_clock::now();
+    long long steals = 0;
+    int workers = 0;
+
+    {
+        ThreadPool pool(threadCount);
+        workers = pool.size();
+
+        for (size_t i = 0; i < requests.size(); ++i)
+            scheduleDay(pool, requests[i], results[i]);
+
+        pool.wait();
+        steals = pool.steals.load();
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    if (previous) std::cout.rdbuf(previous);
+
+
+    // ================================================================
+    //                     REPORT
+    // ================================================================
+
+    std::cout << std::left
+              << std::setw(5) << "Day" << std::setw(28) << "Input"
+              << std::right
+              << std::setw(12) << "Parse ms" << std::setw(12) << "Part 1 ms" << std::setw(12) << "Part 2 ms"
+              << std::setw(12) << "RSS KiB"
+              << "  " << std::left << std::setw(18) << "Part 1" << "Part 2" << std::endl;
+
+    bool failed = false;
+
+    for (const RunResult& r : results) {
+
+        std::string input = r.request.path;
+        if (input.size() > 27) input = "..." + input.substr(input.size() - 24);
+
+        std::cout << std::left
+                  << std::setw(5) << r.request.day << std::setw(28) << input
+                  << std::right
+                  << std::setw(12) << formatMs(r.parseMs) << std::setw(12) << formatMs(r.part1Ms)
+                  << std::setw(12) << formatMs(r.part2Ms) << std::setw(12) << r.peakRssKb
+                  << "  " << std::left;
+
+        if (!r.error.empty()) {
+            std::cout << "error: " << r.error << std::endl;
+            failed = true;
+        }
+        else {
+            std::cout << std::setw(18) << (r.request.part1 ? r.part1 : "-")
+                      << (r.request.part2 ? r.part2 : "-") << std::endl;
+            if (r.part1.rfind("error", 0) == 0 || r.part2.rfind("error", 0) == 0)
+                failed = true;
+        }
+    }
+
+    double wallMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+    std::cout << "\n" << results.size() << " runs on " << workers << " threads ("
+              << steals << " steals), wall " << formatMs(wallMs) << " ms, peak RSS "
+              << peakRssKb() << " KiB" << std::endl;
+
+    if (!metricsPath.empty()) {
+
+        if (!Instrumentation::enabled())
+            std::cerr << "warning: built without AOC_INSTRUMENT, counters are all zero" << std::endl;
+
+        if (!Instrumentation::instance().writeFile(metricsPath)) {
+            std::cerr << "cannot write " << metricsPath << std::endl;
+            failed = true;
+        }
+    }
+
+    return failed ? 1 : 0;
+}